@@ -0,0 +1,43 @@
+#version 330 core
+// Generates one bar or dot quad per instance from a single magnitude. With
+// mirroring every magnitude feeds two instances (left, then right).
+layout (location = 0) in float aMagnitude;
+uniform int uShape; // 0: Bars, 2: Dots
+uniform int uAnchor; // BarAnchor
+uniform bool uMirrored;
+uniform float uBarWidth;
+uniform float uHeightScale;
+out vec2 LocalPos;
+out float vIntensity;
+
+vec2 anchored(vec2 p) {
+    if (uAnchor == 1) return vec2(p.x, -p.y);        // Top
+    if (uAnchor == 2) return vec2(p.y, -p.x);        // Left
+    if (uAnchor == 3) return vec2(-p.y, p.x);        // Right
+    if (uAnchor == 4) return vec2(p.x, p.y - 1.0);   // Center
+    return p;                                        // Bottom
+}
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    float x;
+    if (uMirrored) {
+        float bar = float(gl_InstanceID >> 1);
+        x = (gl_InstanceID & 1) == 0 ? -bar * uBarWidth - uBarWidth : bar * uBarWidth;
+    } else {
+        x = -1.0 + float(gl_InstanceID) * uBarWidth;
+    }
+    float h = min(aMagnitude * uHeightScale, 2.0);
+
+    vec2 position;
+    if (uShape == 2) {
+        float halfSize = uBarWidth * 0.4;
+        vec2 center = anchored(vec2(x + uBarWidth * 0.5, -1.0 + h));
+        position = center + (corner * 2.0 - 1.0) * halfSize;
+    } else {
+        position = anchored(vec2(x + corner.x * uBarWidth, -1.0 + corner.y * h));
+    }
+    gl_Position = vec4(position, 0.0, 1.0);
+    LocalPos = corner;
+    vIntensity = 1.0;
+}
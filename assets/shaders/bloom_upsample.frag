@@ -0,0 +1,24 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec2 TexCoord;
+
+uniform sampler2D uTexture;
+uniform vec2 uTexel;
+uniform float uWeight;
+
+// 3x3 tent over the coarser level, scaled by uWeight. Bloom blends it
+// additively into the next finer level; the lyrics blur writes it at 1.
+void main() {
+    vec3 result = texture(uTexture, TexCoord).rgb * 4.0;
+    result += texture(uTexture, TexCoord + vec2(-uTexel.x, 0.0)).rgb * 2.0;
+    result += texture(uTexture, TexCoord + vec2( uTexel.x, 0.0)).rgb * 2.0;
+    result += texture(uTexture, TexCoord + vec2(0.0, -uTexel.y)).rgb * 2.0;
+    result += texture(uTexture, TexCoord + vec2(0.0,  uTexel.y)).rgb * 2.0;
+    result += texture(uTexture, TexCoord + vec2(-uTexel.x, -uTexel.y)).rgb;
+    result += texture(uTexture, TexCoord + vec2( uTexel.x, -uTexel.y)).rgb;
+    result += texture(uTexture, TexCoord + vec2(-uTexel.x,  uTexel.y)).rgb;
+    result += texture(uTexture, TexCoord + vec2( uTexel.x,  uTexel.y)).rgb;
+
+    FragColor = vec4(result * (uWeight / 16.0), 1.0);
+}
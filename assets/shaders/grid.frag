@@ -0,0 +1,7 @@
+#version 330 core
+out vec4 FragColor;
+in float vWeight;
+uniform vec4 uColor;
+void main() {
+    FragColor = vec4(uColor.rgb, uColor.a * vWeight);
+}
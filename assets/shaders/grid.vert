@@ -0,0 +1,8 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in float aWeight; // Relative line strength
+out float vWeight;
+void main() {
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    vWeight = aWeight;
+}
@@ -0,0 +1,14 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec2 TexCoord;
+
+uniform sampler2D uFast;
+uniform sampler2D uSlow;
+uniform float uSlowWeight;
+
+void main() {
+    vec3 fast = texture(uFast, TexCoord).rgb;
+    vec3 slow = texture(uSlow, TexCoord).rgb;
+    FragColor = vec4(fast + slow * uSlowWeight, 1.0);
+}
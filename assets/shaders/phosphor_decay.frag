@@ -0,0 +1,20 @@
+#version 330 core
+
+layout (location = 0) out vec4 FastColor;
+layout (location = 1) out vec4 SlowColor;
+in vec2 TexCoord;
+
+uniform sampler2D uFast;
+uniform sampler2D uSlow;
+uniform float uFastRetain;
+uniform float uSlowRetain;
+uniform float uTransfer;
+
+// Both phosphor layers decay in one pass; the slow layer also captures a
+// share of the energy leaving the fast one.
+void main() {
+    vec4 fast = texture(uFast, TexCoord);
+    vec3 slow = texture(uSlow, TexCoord).rgb;
+    FastColor = vec4(fast.rgb * uFastRetain, fast.a);
+    SlowColor = vec4(slow * uSlowRetain + fast.rgb * uTransfer, 1.0);
+}
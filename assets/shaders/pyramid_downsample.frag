@@ -0,0 +1,43 @@
+#version 330 core
+
+layout (location = 0) out vec4 BlurColor;
+layout (location = 1) out vec4 BrightColor;
+in vec2 TexCoord;
+
+// Level 0 reads the scene through uTexture for both chains. Later levels
+// read the previous level's blurred and bright-pass attachments.
+uniform sampler2D uTexture;
+uniform sampler2D uBright;
+uniform vec2 uHalfTexel;
+uniform float uThreshold;
+uniform float uSoftKnee;
+uniform bool uPrefilter;
+
+vec3 prefilter(vec3 color) {
+    float brightness = max(max(color.r, color.g), color.b);
+    float knee = max(uSoftKnee, 0.0001);
+    float soft = clamp(brightness - uThreshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 0.0001);
+    float contribution = max(brightness - uThreshold, soft);
+    contribution /= max(brightness, 0.0001);
+    return color * contribution;
+}
+
+// Dual-filter downsample: the centre plus four bilinear taps half a
+// destination texel away cover a 4x4 source footprint in five fetches.
+void main() {
+    const vec2 corners[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+    vec3 centre = texture(uTexture, TexCoord).rgb;
+    vec3 blur = centre * 4.0;
+    vec3 bright = (uPrefilter ? prefilter(centre) : texture(uBright, TexCoord).rgb) * 4.0;
+    for (int i = 0; i < 4; ++i) {
+        vec2 uv = TexCoord + corners[i] * uHalfTexel;
+        vec3 color = texture(uTexture, uv).rgb;
+        blur += color;
+        bright += uPrefilter ? prefilter(color) : texture(uBright, uv).rgb;
+    }
+
+    BlurColor = vec4(blur * 0.125, 1.0);
+    BrightColor = vec4(bright * 0.125, 1.0);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+// One bar per instance, standing on uBaseline and growing along uDirection.
+// Geometry matches drawRoundedRect(x, baseline + dir * h, halfWidth, h).
+layout (location = 0) in float aHeight;
+uniform float uLeft;
+uniform float uCell;
+uniform float uHalfWidth;
+uniform float uBaseline;
+uniform float uDirection;
+out vec2 TexCoord;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    float centerX = uLeft + (float(gl_InstanceID) + 0.5) * uCell;
+    float x = centerX + (corner.x * 2.0 - 1.0) * uHalfWidth;
+    float y = uBaseline + corner.y * 2.0 * aHeight * uDirection;
+    gl_Position = vec4(x, y, 0.0, 1.0);
+    TexCoord = corner;
+}
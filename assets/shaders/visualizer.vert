@@ -2,10 +2,12 @@
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aLocalPos; // Local pos within the bar [0,1]
 layout (location = 2) in float aIntensity;
+layout (location = 3) in vec2 aOffset; // Ribbon offset per pixel of half width
+uniform float uHalfWidth = 0.0;
 out vec2 LocalPos;
 out float vIntensity;
 void main() {
-    gl_Position = vec4(aPos.x, aPos.y, 0.0, 1.0);
+    gl_Position = vec4(aPos + aOffset * uHalfWidth, 0.0, 1.0);
     LocalPos = aLocalPos;
     vIntensity = aIntensity;
 }
@@ -0,0 +1,57 @@
+#version 330 core
+// Expands an XY centerline into ribbon quads. Each instance is one segment;
+// gl_VertexID 0..3 selects its end and side. Texels hold x, y, intensity and
+// a break flag that blanks the segment leading into that point.
+uniform samplerBuffer uCenterline;
+uniform int uPointCount;
+uniform vec2 uViewport;
+uniform float uXScale = 1.0;
+uniform float uHalfWidth = 1.0;
+out vec2 LocalPos;
+out float vIntensity;
+
+vec4 fetchPoint(int index) {
+    vec4 point = texelFetch(uCenterline, clamp(index, 0, uPointCount - 1));
+    point.x *= uXScale;
+    return point;
+}
+
+bool direction(vec4 from, vec4 to, out vec2 dir) {
+    vec2 delta = (to.xy - from.xy) * uViewport * 0.5;
+    float len = length(delta);
+    dir = len > 1e-5 ? delta / len : vec2(0.0);
+    return len > 1e-5;
+}
+
+void main() {
+    int segment = gl_InstanceID;
+    int end = gl_VertexID >> 1;
+    int index = segment + end;
+    vec4 point = fetchPoint(index);
+    if (fetchPoint(segment + 1).w > 0.5) {
+        gl_Position = vec4(2.0, 2.0, 0.0, 1.0);
+        LocalPos = vec2(0.0);
+        vIntensity = 0.0;
+        return;
+    }
+
+    // Same mitered join as VisualizerGeometry::buildUnitTraceRibbon.
+    vec2 incoming, outgoing;
+    bool hasIncoming = index > 0 && point.w < 0.5 && direction(fetchPoint(index - 1), point, incoming);
+    bool hasOutgoing = index + 1 < uPointCount && fetchPoint(index + 1).w < 0.5 &&
+                       direction(point, fetchPoint(index + 1), outgoing);
+    if (!hasIncoming && hasOutgoing) incoming = outgoing;
+    else if (hasIncoming && !hasOutgoing) outgoing = incoming;
+    else if (!hasIncoming && !hasOutgoing) incoming = outgoing = vec2(1.0, 0.0);
+
+    vec2 tangent = incoming + outgoing;
+    tangent = length(tangent) > 1e-5 ? normalize(tangent) : outgoing;
+    vec2 normal = vec2(-tangent.y, tangent.x);
+    float alignment = abs(dot(normal, vec2(-outgoing.y, outgoing.x)));
+    float miter = min(1.0 / max(alignment, 0.25), 2.0) * uHalfWidth;
+
+    float side = (gl_VertexID & 1) == 0 ? 1.0 : -1.0;
+    gl_Position = vec4(point.xy + side * normal * miter * 2.0 / uViewport, 0.0, 1.0);
+    LocalPos = vec2(float(end), (gl_VertexID & 1) == 0 ? 0.0 : 1.0);
+    vIntensity = point.z;
+}
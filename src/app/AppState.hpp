@@ -47,6 +47,7 @@ struct VisualizerLayer {
     BarAnchor barAnchor = BarAnchor::Bottom;
     XYLayerSettings xy;
     XYMeasurements xyMeasurements;
+    XYTraceStats xyTraceStats;
 };
 
 struct VideoRenderSettings {
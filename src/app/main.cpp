@@ -14,6 +14,8 @@
 #include "RenderManager.hpp"
 #include "UIManager.hpp"
 #include "VideoRenderManager.hpp"
+#include "GpuProfiler.hpp"
+#include "CpuProfiler.hpp"
 #include "ConfigLogic.hpp"
 #include "AssetPaths.hpp"
 
@@ -129,6 +131,8 @@ int main() {
     RenderManager renderManager;
     UIManager uiManager;
     VideoRenderManager videoRenderManager;
+    GpuProfiler gpuProfiler;
+    renderManager.setGpuProfiler(&gpuProfiler);
 
     // Initial load
     ConfigLogic::loadSettings(state);
@@ -142,6 +146,7 @@ int main() {
     // Frame limiting state
     double lastTime = glfwGetTime();
 
+    PLASMOID_PROFILE_THREAD("main");
     while (!glfwWindowShouldClose(window)) {
         // Runtime VSync toggle
         if (state.enableVsync != prevVsync) {
@@ -170,6 +175,8 @@ int main() {
         // Record frame time for statistics
         systemStats.recordFrameTime(io.DeltaTime);
 
+        gpuProfiler.beginFrame();
+
         // 1. Render Visualization Frame
         renderManager.renderFrame(
             state, 
@@ -199,20 +206,31 @@ int main() {
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
-        uiManager.renderUI(
-            state, 
-            audioEngine, 
-            particleSystem, 
-            oscMusicEditor, 
-            systemStats,
-            videoRenderManager,
-            window
-        );
+        {
+            PLASMOID_PROFILE_ZONE("ui");
+            uiManager.renderUI(
+                state,
+                audioEngine,
+                particleSystem,
+                oscMusicEditor,
+                systemStats,
+                videoRenderManager,
+                gpuProfiler,
+                window
+            );
+        }
 
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            GpuProfiler::Scope timer(&gpuProfiler, "imgui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        gpuProfiler.endFrame();
 
-        glfwSwapBuffers(window);
+        {
+            PLASMOID_PROFILE_ZONE("swap");
+            glfwSwapBuffers(window);
+        }
         
         // Frame limiting
         if (!state.enableVsync && state.targetFps > 0) {
@@ -225,6 +243,7 @@ int main() {
         } else {
              lastTime = glfwGetTime(); // Just update for reference if needed
         }
+        PLASMOID_PROFILE_FRAME();
     }
 
     ImGui_ImplOpenGL3_Shutdown();
@@ -1,4 +1,5 @@
 #include "AnalysisEngine.hpp"
+#include "CpuProfiler.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -18,6 +19,7 @@ AnalysisEngine::~AnalysisEngine() {
 
 void AnalysisEngine::computeFFT(const std::vector<float>& buffer) {
     if (buffer.empty()) return;
+    PLASMOID_PROFILE_FUNCTION();
 
     // Fill input buffer with Hanning window
     size_t n = std::min(buffer.size(), m_fftSize);
@@ -41,6 +43,7 @@ void AnalysisEngine::computeFFT(const std::vector<float>& buffer) {
 }
 
 std::vector<float> AnalysisEngine::computeLayerMagnitudes(const LayerConfig& config, std::vector<float>& prevMagnitudes) {
+    PLASMOID_PROFILE_FUNCTION();
     std::vector<float> layerMagnitudes(config.numBars);
     if (prevMagnitudes.size() != config.numBars) {
         prevMagnitudes.assign(config.numBars, 0.0f);
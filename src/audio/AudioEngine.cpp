@@ -1,6 +1,7 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include "AudioEngine.hpp"
 #include "Utf8Paths.hpp"
+#include "CpuProfiler.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -42,6 +43,8 @@ AudioEngine::~AudioEngine() {
 void AudioEngine::dataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount) {
     AudioEngine* pEngine = (AudioEngine*)pDevice->pUserData;
     if (pEngine == nullptr) return;
+    PLASMOID_PROFILE_REALTIME_THREAD("audio");
+    PLASMOID_PROFILE_ZONE("audio callback");
 
     ma_uint32 framesRead = 0;
     if (pEngine->m_testTone) {
@@ -407,6 +410,7 @@ bool AudioEngine::loadFile(const std::string& filePath) {
     deviceConfig.dataCallback      = dataCallback;
     deviceConfig.pUserData         = this;
 
+    PLASMOID_PROFILE_RESERVE_THREAD();
     result = ma_device_init(NULL, &deviceConfig, &m_device);
     if (result != MA_SUCCESS) {
         std::cerr << "Failed to open playback device. (Error: " << result << ")" << std::endl;
@@ -438,6 +442,7 @@ bool AudioEngine::startCapture(const ma_device_id* pID, ma_device_type type) {
     deviceConfig.dataCallback = dataCallback;
     deviceConfig.pUserData = this;
 
+    PLASMOID_PROFILE_RESERVE_THREAD();
     if (ma_device_init(NULL, &deviceConfig, &m_device) != MA_SUCCESS) {
         std::cerr << "Failed to initialize capture device" << std::endl;
         return false;
@@ -472,6 +477,7 @@ bool AudioEngine::initTestTone() {
     deviceConfig.dataCallback      = dataCallback;
     deviceConfig.pUserData         = this;
 
+    PLASMOID_PROFILE_RESERVE_THREAD();
     ma_result result = ma_device_init(NULL, &deviceConfig, &m_device);
     if (result != MA_SUCCESS) {
         std::cerr << "Failed to init device for test tone. Error: " << result << std::endl;
@@ -497,6 +503,7 @@ bool AudioEngine::initOscMusic(int sampleRate) {
     deviceConfig.dataCallback      = dataCallback;
     deviceConfig.pUserData         = this;
 
+    PLASMOID_PROFILE_RESERVE_THREAD();
     ma_result result = ma_device_init(NULL, &deviceConfig, &m_device);
     if (result != MA_SUCCESS) {
         std::cerr << "Failed to init device for OscMusic at " << sampleRate << "Hz. Error: " << result << std::endl;
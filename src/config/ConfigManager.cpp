@@ -14,17 +14,20 @@ toml::table writeXYSettings(const XYLayerSettings& xy) {
         {"profile", static_cast<int>(xy.profile)}, {"persistence", xy.persistence},
         {"window_scale", xy.windowScale}, {"coupling_x", static_cast<int>(xy.couplingX)},
         {"coupling_y", static_cast<int>(xy.couplingY)}, {"ac_cutoff_hz", xy.acCutoffHz},
-        {"bandwidth_hz", xy.bandwidthHz}, {"gain_x", xy.gainX}, {"gain_y", xy.gainY},
+        {"bandwidth_hz", xy.bandwidthHz}, {"upsample_factor", xy.upsampleFactor},
+        {"gain_x", xy.gainX}, {"gain_y", xy.gainY},
         {"position_x", xy.positionX}, {"position_y", xy.positionY},
         {"invert_x", xy.invertX}, {"invert_y", xy.invertY}, {"rotation", xy.rotationDegrees},
         {"auto_gain", xy.autoGain}, {"trigger_mode", static_cast<int>(xy.triggerMode)},
         {"trigger_source", static_cast<int>(xy.triggerSource)}, {"trigger_edge", static_cast<int>(xy.triggerEdge)},
         {"trigger_level", xy.triggerLevel}, {"trigger_hysteresis", xy.triggerHysteresis},
         {"trigger_holdoff_ms", xy.triggerHoldoffMs}, {"jump_blanking", xy.jumpBlanking},
+        {"simplify_trace", xy.simplifyTrace}, {"simplify_tolerance_px", xy.simplifyTolerancePx},
         {"trace_width", xy.traceWidth}, {"bloom", xy.bloom}, {"beam_head_size", xy.beamHeadSize},
         {"beam_intensity", xy.beamIntensity}, {"dwell_effect", xy.dwellEffect},
-        {"density_effect", xy.densityEffect}, {"z_mode", static_cast<int>(xy.zMode)},
-        {"z_gain", xy.zGain}, {"z_offset", xy.zOffset}
+        {"density_effect", xy.densityEffect}, {"cpu_phosphor", xy.cpuPhosphor}, {"z_mode", static_cast<int>(xy.zMode)},
+        {"z_gain", xy.zGain}, {"z_offset", xy.zOffset},
+        {"measurement_rate_hz", xy.measurementRateHz}
     };
 }
 
@@ -33,6 +36,7 @@ void readXYSettings(const toml::table& table, XYLayerSettings& xy) {
     xy.persistence = table["persistence"].value_or(true); xy.windowScale = table["window_scale"].value_or(1.0f);
     xy.couplingX = static_cast<CouplingMode>(table["coupling_x"].value_or(0)); xy.couplingY = static_cast<CouplingMode>(table["coupling_y"].value_or(0));
     xy.acCutoffHz = table["ac_cutoff_hz"].value_or(5.0f); xy.bandwidthHz = table["bandwidth_hz"].value_or(20000.0f);
+    xy.upsampleFactor = table["upsample_factor"].value_or(1);
     xy.gainX = table["gain_x"].value_or(1.0f); xy.gainY = table["gain_y"].value_or(1.0f);
     xy.positionX = table["position_x"].value_or(0.0f); xy.positionY = table["position_y"].value_or(0.0f);
     xy.invertX = table["invert_x"].value_or(false); xy.invertY = table["invert_y"].value_or(false); xy.rotationDegrees = table["rotation"].value_or(0.0f);
@@ -40,9 +44,12 @@ void readXYSettings(const toml::table& table, XYLayerSettings& xy) {
     xy.triggerSource = static_cast<TriggerSource>(table["trigger_source"].value_or(0)); xy.triggerEdge = static_cast<TriggerEdge>(table["trigger_edge"].value_or(0));
     xy.triggerLevel = table["trigger_level"].value_or(0.0f); xy.triggerHysteresis = table["trigger_hysteresis"].value_or(0.02f);
     xy.triggerHoldoffMs = table["trigger_holdoff_ms"].value_or(0.0f); xy.jumpBlanking = table["jump_blanking"].value_or(0.35f);
+    xy.simplifyTrace = table["simplify_trace"].value_or(false); xy.simplifyTolerancePx = table["simplify_tolerance_px"].value_or(0.5f);
     xy.traceWidth = table["trace_width"].value_or(2.0f); xy.bloom = table["bloom"].value_or(1.0f); xy.beamHeadSize = table["beam_head_size"].value_or(0.0f);
     xy.beamIntensity = table["beam_intensity"].value_or(1.0f); xy.dwellEffect = table["dwell_effect"].value_or(0.0f); xy.densityEffect = table["density_effect"].value_or(0.0f);
+    xy.cpuPhosphor = table["cpu_phosphor"].value_or(false);
     xy.zMode = static_cast<ZIntensityMode>(table["z_mode"].value_or(0)); xy.zGain = table["z_gain"].value_or(1.0f); xy.zOffset = table["z_offset"].value_or(0.0f);
+    xy.measurementRateHz = table["measurement_rate_hz"].value_or(10.0f);
 }
 }
 
@@ -91,10 +98,12 @@ bool ConfigManager::save(const std::string& filename, const AppConfig& config) {
     tbl.insert_or_assign("oscilloscope", toml::table{
         {"profile", static_cast<int>(config.oscilloscopeDisplay.profile)}, {"graticule_enabled", config.oscilloscopeDisplay.graticuleEnabled},
         {"graticule_opacity", config.oscilloscopeDisplay.graticuleOpacity}, {"graticule_columns", config.oscilloscopeDisplay.graticuleColumns},
-        {"graticule_rows", config.oscilloscopeDisplay.graticuleRows}, {"fast_decay_ms", config.oscilloscopeDisplay.phosphorFastDecayMs},
+        {"graticule_rows", config.oscilloscopeDisplay.graticuleRows}, {"graticule_ticks", config.oscilloscopeDisplay.graticuleTicks},
+        {"graticule_crosshair", config.oscilloscopeDisplay.graticuleCrosshair}, {"fast_decay_ms", config.oscilloscopeDisplay.phosphorFastDecayMs},
         {"slow_decay_ms", config.oscilloscopeDisplay.phosphorSlowDecayMs}, {"slow_weight", config.oscilloscopeDisplay.phosphorSlowWeight},
         {"saturation", config.oscilloscopeDisplay.phosphorSaturation}, {"decay_color_shift", config.oscilloscopeDisplay.decayColorShift},
-        {"measurement_overlay", config.oscilloscopeDisplay.measurementOverlay}, {"overlay_in_video", config.oscilloscopeDisplay.overlayInVideo}
+        {"measurement_overlay", config.oscilloscopeDisplay.measurementOverlay}, {"overlay_in_video", config.oscilloscopeDisplay.overlayInVideo},
+        {"gpu_ribbon_expansion", config.oscilloscopeDisplay.gpuRibbonExpansion}
     });
 
     tbl.insert_or_assign("media_overlay", toml::table{
@@ -240,6 +249,8 @@ bool ConfigManager::load(const std::string& filename, AppConfig& config) {
             config.oscilloscopeDisplay.graticuleOpacity = (*scope)["graticule_opacity"].value_or(0.18f);
             config.oscilloscopeDisplay.graticuleColumns = (*scope)["graticule_columns"].value_or(10);
             config.oscilloscopeDisplay.graticuleRows = (*scope)["graticule_rows"].value_or(8);
+            config.oscilloscopeDisplay.graticuleTicks = (*scope)["graticule_ticks"].value_or(false);
+            config.oscilloscopeDisplay.graticuleCrosshair = (*scope)["graticule_crosshair"].value_or(false);
             config.oscilloscopeDisplay.phosphorFastDecayMs = (*scope)["fast_decay_ms"].value_or(65.0f);
             config.oscilloscopeDisplay.phosphorSlowDecayMs = (*scope)["slow_decay_ms"].value_or(500.0f);
             config.oscilloscopeDisplay.phosphorSlowWeight = (*scope)["slow_weight"].value_or(0.25f);
@@ -247,6 +258,7 @@ bool ConfigManager::load(const std::string& filename, AppConfig& config) {
             config.oscilloscopeDisplay.decayColorShift = (*scope)["decay_color_shift"].value_or(0.08f);
             config.oscilloscopeDisplay.measurementOverlay = (*scope)["measurement_overlay"].value_or(false);
             config.oscilloscopeDisplay.overlayInVideo = (*scope)["overlay_in_video"].value_or(false);
+            config.oscilloscopeDisplay.gpuRibbonExpansion = (*scope)["gpu_ribbon_expansion"].value_or(false);
         }
 
         if (auto overlay = tbl["media_overlay"].as_table()) {
@@ -1,5 +1,6 @@
 #include "VideoRenderManager.hpp"
 #include "Utf8Paths.hpp"
+#include "CpuProfiler.hpp"
 #include <iostream>
 #include <GL/glew.h>
 
@@ -106,6 +107,7 @@ void VideoRenderManager::update(
     RenderManager& renderManager
 ) {
     if (!state.videoStatus.isRendering || !m_pipe) return;
+    PLASMOID_PROFILE_FUNCTION();
 
     if (state.videoStatus.currentFrame >= state.videoStatus.totalFrames) {
 #ifdef _WIN32
@@ -147,9 +149,15 @@ void VideoRenderManager::update(
         static_cast<std::uint32_t>(m_sampleRate)
     );
 
-    glReadPixels(0, 0, state.videoSettings.width, state.videoSettings.height, GL_RGB, GL_UNSIGNED_BYTE, m_pixelBuffer.data());
+    {
+        PLASMOID_PROFILE_ZONE("read pixels");
+        glReadPixels(0, 0, state.videoSettings.width, state.videoSettings.height, GL_RGB, GL_UNSIGNED_BYTE, m_pixelBuffer.data());
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, 0); // Restore default FBO for UI
-    fwrite(m_pixelBuffer.data(), 1, m_pixelBuffer.size(), m_pipe);
+    {
+        PLASMOID_PROFILE_ZONE("encode");
+        fwrite(m_pixelBuffer.data(), 1, m_pixelBuffer.size(), m_pipe);
+    }
 
     state.videoStatus.currentFrame++;
     state.videoStatus.progress = (float)state.videoStatus.currentFrame / state.videoStatus.totalFrames;
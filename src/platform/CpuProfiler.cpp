@@ -0,0 +1,294 @@
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Minimum gap between automatic captures, so writing one trace cannot
+// trigger the next.
+constexpr long long AutoCaptureCooldownNs = 5'000'000'000LL;
+
+long long nowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+// Fields are relaxed atomics so the exporting thread may read a slot the
+// owner is rewriting; such slots are detected and dropped.
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<long long> start{0};
+    std::atomic<long long> end{0};
+};
+
+struct ThreadRing {
+    std::atomic<unsigned> id{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<size_t> written{0};
+    // Events before this index belong to a thread that has since exited.
+    std::atomic<size_t> firstEvent{0};
+    std::atomic<bool> inUse{false};
+    std::atomic<bool> reserved{false};
+    std::unique_ptr<Event[]> events = std::make_unique<Event[]>(CpuProfiler::RingCapacity);
+};
+
+// Rings are never freed. A thread that exits hands its ring back and the
+// next new thread adopts it, so memory is bounded by the peak thread count.
+constexpr size_t MaxRings = 64;
+
+struct Registry {
+    std::array<std::atomic<ThreadRing*>, MaxRings> rings{};
+    std::atomic<unsigned> nextId{1};
+    // Serialises adding rings; claiming an existing one takes no lock.
+    std::mutex growMutex;
+    std::atomic<float> budgetMs{0.0f};
+    // Touched only by the thread calling frameMark().
+    long long lastFrame = 0;
+    long long lastCapture = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Reserved rings are set aside for real-time threads and never handed to
+// ordinary ones.
+ThreadRing* claimFreeRing(bool reserved) noexcept {
+    for (auto& slot : registry().rings) {
+        ThreadRing* ring = slot.load(std::memory_order_acquire);
+        if (!ring) break;
+        if (ring->reserved.load(std::memory_order_relaxed) != reserved) continue;
+        bool expected = false;
+        if (!ring->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) continue;
+        ring->id.store(registry().nextId++, std::memory_order_relaxed);
+        ring->name.store(nullptr, std::memory_order_relaxed);
+        ring->firstEvent.store(ring->written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return ring;
+    }
+    return nullptr;
+}
+
+// Adds a free ring to the table. Returns false once the table is full.
+bool addRing(bool reserved) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.growMutex);
+    for (auto& slot : reg.rings) {
+        if (slot.load(std::memory_order_relaxed)) continue;
+        auto* ring = new ThreadRing;
+        ring->reserved.store(reserved, std::memory_order_relaxed);
+        slot.store(ring, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+// Plain values, so reading them never registers a TLS destructor. Threads
+// that must not allocate (real-time, or already exiting) set t_fixedRing
+// and record only into t_ring, if they have one.
+thread_local ThreadRing* t_ring = nullptr;
+thread_local bool t_fixedRing = false;
+
+// Claimed on an ordinary thread's first zone and handed back when the
+// thread exits. The ring keeps that thread's zones for the next trace
+// until another thread adopts it.
+struct RingHolder {
+    ThreadRing* ring = nullptr;
+
+    RingHolder() {
+        ring = claimFreeRing(false);
+        if (!ring && addRing(false)) ring = claimFreeRing(false);
+    }
+    ~RingHolder() {
+        if (ring) ring->inUse.store(false, std::memory_order_release);
+        t_ring = nullptr;
+        t_fixedRing = true;
+    }
+};
+
+ThreadRing* threadRing() {
+    if (!t_ring && !t_fixedRing) {
+        thread_local RingHolder holder;
+        t_ring = holder.ring;
+    }
+    return t_ring;
+}
+
+void record(const char* name, long long start, long long end) noexcept {
+    ThreadRing* ring = threadRing();
+    if (!ring) return;
+    const size_t index = ring->written.load(std::memory_order_relaxed);
+    Event& event = ring->events[index % CpuProfiler::RingCapacity];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+struct Snapshot {
+    unsigned thread = 0;
+    const char* name = nullptr;
+    long long start = 0;
+    long long end = 0;
+};
+
+void copyRing(const ThreadRing& ring, std::vector<Snapshot>& out) {
+    const unsigned id = ring.id.load(std::memory_order_relaxed);
+    const size_t written = ring.written.load(std::memory_order_acquire);
+    const size_t first = std::max(
+        written - std::min(written, CpuProfiler::RingCapacity),
+        ring.firstEvent.load(std::memory_order_relaxed));
+    const size_t begin = out.size();
+    for (size_t i = first; i < written; ++i) {
+        const Event& event = ring.events[i % CpuProfiler::RingCapacity];
+        out.push_back({id,
+            event.name.load(std::memory_order_relaxed),
+            event.start.load(std::memory_order_relaxed),
+            event.end.load(std::memory_order_relaxed)});
+    }
+    // Slots the owner lapped while we copied may be torn.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const size_t after = ring.written.load(std::memory_order_relaxed);
+    const size_t stale = after > CpuProfiler::RingCapacity ? after - CpuProfiler::RingCapacity : 0;
+    if (stale > first) {
+        const size_t drop = std::min(stale - first, written - first);
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(begin),
+                  out.begin() + static_cast<std::ptrdiff_t>(begin + drop));
+    }
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text ? text : "?"; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+}
+
+CpuProfiler::Zone::Zone(const char* name) noexcept
+    : m_name(name), m_start(nowNs()) {}
+
+CpuProfiler::Zone::~Zone() {
+    record(m_name, m_start, nowNs());
+}
+
+void CpuProfiler::setThreadName(const char* name) noexcept {
+    if (ThreadRing* ring = threadRing()) ring->name.store(name, std::memory_order_relaxed);
+}
+
+void CpuProfiler::reserveThread() {
+    // The previous real-time thread is gone, so its reserved rings are free.
+    bool available = false;
+    for (auto& slot : registry().rings) {
+        ThreadRing* ring = slot.load(std::memory_order_acquire);
+        if (!ring) break;
+        if (!ring->reserved.load(std::memory_order_relaxed)) continue;
+        ring->inUse.store(false, std::memory_order_release);
+        available = true;
+    }
+    if (!available) addRing(true);
+}
+
+void CpuProfiler::setRealtimeThread(const char* name) noexcept {
+    if (!t_fixedRing) {
+        t_fixedRing = true;
+        t_ring = claimFreeRing(true);
+    }
+    if (!t_ring) return;
+    t_ring->name.store(name, std::memory_order_relaxed);
+}
+
+void CpuProfiler::setFrameBudgetMs(float budgetMs) noexcept {
+    registry().budgetMs.store(std::max(budgetMs, 0.0f), std::memory_order_relaxed);
+}
+
+float CpuProfiler::frameBudgetMs() noexcept {
+    return registry().budgetMs.load(std::memory_order_relaxed);
+}
+
+void CpuProfiler::frameMark() {
+    Registry& reg = registry();
+    const long long now = nowNs();
+    const long long previous = reg.lastFrame;
+    reg.lastFrame = now;
+    if (previous == 0) return;
+    record("frame", previous, now);
+
+    const float budgetMs = reg.budgetMs.load(std::memory_order_relaxed);
+    const float frameMs = static_cast<float>(now - previous) / 1.0e6f;
+    if (budgetMs <= 0.0f || frameMs <= budgetMs) return;
+    if (reg.lastCapture != 0 && now - reg.lastCapture < AutoCaptureCooldownNs) return;
+    reg.lastCapture = now;
+    const auto path = writeTrace();
+    if (!path.empty()) {
+        std::cout << "[Profiler] Frame took " << frameMs << " ms (budget " << budgetMs
+                  << " ms); trace written to " << path.string() << std::endl;
+    }
+}
+
+std::filesystem::path CpuProfiler::writeTrace() {
+    const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::filesystem::path path =
+        std::filesystem::absolute("plasmoid-trace-" + std::to_string(stamp) + ".json");
+    return writeTrace(path) ? path : std::filesystem::path{};
+}
+
+bool CpuProfiler::writeTrace(const std::filesystem::path& path) {
+    std::vector<const ThreadRing*> rings;
+    for (const auto& slot : registry().rings) {
+        const ThreadRing* ring = slot.load(std::memory_order_acquire);
+        if (!ring) break;
+        rings.push_back(ring);
+    }
+
+    std::vector<Snapshot> events;
+    for (const auto& ring : rings) copyRing(*ring, events);
+    long long origin = 0;
+    if (!events.empty()) {
+        origin = std::min_element(events.begin(), events.end(),
+            [](const Snapshot& a, const Snapshot& b) { return a.start < b.start; })->start;
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) file << ",\n";
+        first = false;
+    };
+    for (const auto& ring : rings) {
+        const char* name = ring->name.load(std::memory_order_relaxed);
+        if (!name) continue;
+        separator();
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->id.load(std::memory_order_relaxed)
+             << ",\"args\":{\"name\":";
+        writeJsonString(file, name);
+        file << "}}";
+    }
+    for (const auto& event : events) {
+        separator();
+        file << "{\"name\":";
+        writeJsonString(file, event.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << static_cast<double>(event.start - origin) / 1000.0
+             << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << '}';
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
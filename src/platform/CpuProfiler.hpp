@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+// Scoped CPU zones for frame profiling. Each thread appends finished zones
+// to its own fixed ring, so recording takes no lock; writeTrace() copies
+// the rings into Chrome/Perfetto trace JSON (chrome://tracing, ui.perfetto.dev).
+// Zone and thread names must be string literals or otherwise outlive the
+// process. Without the PLASMOID_PROFILER CMake option the macros below expand
+// to nothing and this class is not built.
+class CpuProfiler {
+public:
+    // Zones kept per thread; older ones are overwritten.
+    static constexpr size_t RingCapacity = 16384;
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) noexcept;
+        ~Zone();
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name;
+        long long m_start;
+    };
+
+    static void setThreadName(const char* name) noexcept;
+    // Sets aside a ring for the next real-time thread, so it can record
+    // without allocating or locking. Call it before starting that thread
+    // (e.g. before ma_device_init), while no real-time thread is recording.
+    static void reserveThread();
+    // Adopts the reserved ring on the calling thread; zones on a real-time
+    // thread without one are dropped rather than allocating.
+    static void setRealtimeThread(const char* name) noexcept;
+
+    // Marks the end of a main-loop frame. A frame longer than the budget
+    // writes a trace of the recent history once the cooldown has passed.
+    static void frameMark();
+    static void setFrameBudgetMs(float budgetMs) noexcept;
+    [[nodiscard]] static float frameBudgetMs() noexcept;
+
+    static bool writeTrace(const std::filesystem::path& path);
+    // Writes a uniquely named trace into the working directory and returns
+    // its path, or an empty path on failure.
+    static std::filesystem::path writeTrace();
+};
+
+#ifdef PLASMOID_PROFILER
+#define PLASMOID_PROFILE_CONCAT_INNER(a, b) a##b
+#define PLASMOID_PROFILE_CONCAT(a, b) PLASMOID_PROFILE_CONCAT_INNER(a, b)
+#define PLASMOID_PROFILE_ZONE(name) \
+    CpuProfiler::Zone PLASMOID_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PLASMOID_PROFILE_FUNCTION() PLASMOID_PROFILE_ZONE(__func__)
+#define PLASMOID_PROFILE_THREAD(name) CpuProfiler::setThreadName(name)
+#define PLASMOID_PROFILE_FRAME() CpuProfiler::frameMark()
+#define PLASMOID_PROFILE_RESERVE_THREAD() CpuProfiler::reserveThread()
+#define PLASMOID_PROFILE_REALTIME_THREAD(name) CpuProfiler::setRealtimeThread(name)
+#else
+#define PLASMOID_PROFILE_ZONE(name) ((void)0)
+#define PLASMOID_PROFILE_FUNCTION() ((void)0)
+#define PLASMOID_PROFILE_THREAD(name) ((void)0)
+#define PLASMOID_PROFILE_FRAME() ((void)0)
+#define PLASMOID_PROFILE_RESERVE_THREAD() ((void)0)
+#define PLASMOID_PROFILE_REALTIME_THREAD(name) ((void)0)
+#endif
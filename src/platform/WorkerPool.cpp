@@ -0,0 +1,89 @@
+#include "WorkerPool.hpp"
+
+#include "CpuProfiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+WorkerPool::WorkerPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        threadCount = std::max(hardware, 2u) - 1;
+    }
+    m_threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this] { run(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void WorkerPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_tasks.empty() && m_active == 0; });
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    struct Shared {
+        std::atomic<size_t> next{0};
+        size_t helpersLeft = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto shared = std::make_shared<Shared>();
+    auto drain = [shared, count, &body] {
+        for (size_t i = shared->next++; i < count; i = shared->next++) body(i);
+    };
+
+    const size_t helpers = std::min<size_t>(m_threads.size(), count - 1);
+    shared->helpersLeft = helpers;
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([shared, drain] {
+            drain();
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (--shared->helpersLeft == 0) shared->done.notify_all();
+        });
+    }
+    drain();
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->done.wait(lock, [&] { return shared->helpersLeft == 0; });
+}
+
+void WorkerPool::run() {
+    PLASMOID_PROFILE_THREAD("worker");
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_active;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active;
+            if (m_tasks.empty() && m_active == 0) m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fixed-size thread pool for CPU work that must stay off the GL thread.
+// Queued tasks are always run; destruction waits for the queue to drain.
+class WorkerPool {
+public:
+    // A thread count of zero selects one thread per spare hardware core.
+    explicit WorkerPool(unsigned threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void waitIdle();
+    // Calls body(i) for every i in [0, count) on the pool and the calling
+    // thread, returning once all calls have finished.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    [[nodiscard]] unsigned threadCount() const noexcept {
+        return static_cast<unsigned>(m_threads.size());
+    }
+
+private:
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    size_t m_active = 0;
+    bool m_stopping = false;
+};
@@ -2,6 +2,7 @@
 
 #include "stb_image.h"
 #include "Utf8Paths.hpp"
+#include "CpuProfiler.hpp"
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
@@ -226,10 +227,12 @@ bool AnimatedBackground::readVideoFrame() {
 }
 
 void AnimatedBackground::videoReaderLoop() {
+    PLASMOID_PROFILE_THREAD("background video");
     std::vector<unsigned char> frame(m_videoFrame.size());
     while (!m_stopVideoThread) {
         const size_t read = std::fread(frame.data(), 1, frame.size(), m_videoPipe);
         if (read != frame.size()) break;
+        PLASMOID_PROFILE_ZONE("background frame");
         flipRows(frame, m_videoWidth, m_videoHeight);
         {
             std::lock_guard<std::mutex> lock(m_videoFrameMutex);
@@ -250,6 +253,7 @@ GLuint AnimatedBackground::update(
     OverlayVideoDecoder decoder,
     int videoFps
 ) {
+    PLASMOID_PROFILE_FUNCTION();
     if (type == OverlayBackgroundType::None || path.empty()) {
         if (m_type != OverlayBackgroundType::None || m_texture != 0 || m_videoPipe) reset();
         return 0;
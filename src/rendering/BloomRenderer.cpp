@@ -2,7 +2,11 @@
 
 #include "AssetPaths.hpp"
 
-#include <algorithm>
+namespace {
+// Each coarser level is folded into the next finer one at this weight, so
+// the halo falls off smoothly instead of ending at the kernel radius.
+constexpr float LevelWeight = 0.75f;
+}
 
 BloomRenderer::~BloomRenderer() {
     if (m_quadVao != 0) glDeleteVertexArrays(1, &m_quadVao);
@@ -12,12 +16,19 @@ BloomRenderer::~BloomRenderer() {
 void BloomRenderer::initialize() {
     if (m_initialized) return;
 
-    m_blurProgram.load(
+    m_upsampleProgram.load(
         AssetPaths::shader("quad.vert"),
-        AssetPaths::shader("blur.frag"));
+        AssetPaths::shader("bloom_upsample.frag"));
     m_compositeProgram.load(
         AssetPaths::shader("quad.vert"),
         AssetPaths::shader("composite.frag"));
+    m_upsampleUniforms = {
+        m_upsampleProgram.uniform("uTexture"),
+        m_upsampleProgram.uniform("uTexel"),
+        m_upsampleProgram.uniform("uWeight")};
+    m_compositeUniforms = {
+        m_compositeProgram.uniform("uBloom"),
+        m_compositeProgram.uniform("uStrength")};
 
     constexpr float quadVertices[] = {
         -1.0f,  1.0f, 0.0f, 1.0f,
@@ -44,60 +55,52 @@ void BloomRenderer::initialize() {
 }
 
 void BloomRenderer::render(
-    GLuint sourceTexture,
+    BlurPyramid& pyramid,
     GLuint targetFramebuffer,
     int width,
     int height,
     float strength
 ) {
-    if (sourceTexture == 0 || width <= 0 || height <= 0 || strength <= 0.0f) return;
+    const int levelCount = pyramid.levelCount();
+    if (levelCount == 0 || width <= 0 || height <= 0 || strength <= 0.0f) return;
     initialize();
 
-    const int bloomWidth = std::max(width / 2, 1);
-    const int bloomHeight = std::max(height / 2, 1);
-    m_ping.resize(bloomWidth, bloomHeight);
-    m_pong.resize(bloomWidth, bloomHeight);
-
     glDisable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
-    glViewport(0, 0, bloomWidth, bloomHeight);
     glBindVertexArray(m_quadVao);
-    glUseProgram(m_blurProgram);
-    glUniform1i(glGetUniformLocation(m_blurProgram, "uTexture"), 0);
-    glUniform1f(glGetUniformLocation(m_blurProgram, "uThreshold"), 1.0f);
-    glUniform1f(glGetUniformLocation(m_blurProgram, "uSoftKnee"), 0.5f);
-
-    GLuint inputTexture = sourceTexture;
-    constexpr int BlurPasses = 8;
-    for (int pass = 0; pass < BlurPasses; ++pass) {
-        Framebuffer& destination = (pass % 2 == 0) ? m_ping : m_pong;
-        destination.bind();
-        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+    glActiveTexture(GL_TEXTURE0);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, inputTexture);
-        glUniform2f(
-            glGetUniformLocation(m_blurProgram, "uDirection"),
-            pass % 2 == 0 ? 1.0f : 0.0f,
-            pass % 2 == 0 ? 0.0f : 1.0f);
-        glUniform1i(glGetUniformLocation(m_blurProgram, "uPrefilter"), pass == 0 ? 1 : 0);
+    // Upsample: accumulate each coarser level into the finer one in place.
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    m_upsampleProgram.use();
+    m_upsampleProgram.set(m_upsampleUniforms.texture, 0);
+    m_upsampleProgram.set(m_upsampleUniforms.weight, LevelWeight);
+    float totalWeight = 1.0f;
+    for (int level = levelCount - 1; level > 0; --level) {
+        const Framebuffer& source = pyramid.level(level);
+        const Framebuffer& destination = pyramid.level(level - 1);
+        destination.bindAttachment(BlurPyramid::BrightAttachment);
+        glViewport(0, 0, destination.width(), destination.height());
+        glBindTexture(GL_TEXTURE_2D, source.texture(BlurPyramid::BrightAttachment));
+        m_upsampleProgram.set(
+            m_upsampleUniforms.texel,
+            1.0f / static_cast<float>(source.width()),
+            1.0f / static_cast<float>(source.height()));
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        inputTexture = destination.texture();
+        totalWeight = 1.0f + LevelWeight * totalWeight;
     }
 
+    // Normalise by the summed level weights so strength stays comparable
+    // to a single blurred copy regardless of the level count.
     glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
     glViewport(0, 0, width, height);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
-    glUseProgram(m_compositeProgram);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, inputTexture);
-    glUniform1i(glGetUniformLocation(m_compositeProgram, "uBloom"), 0);
-    glUniform1f(glGetUniformLocation(m_compositeProgram, "uStrength"), strength);
+    m_compositeProgram.use();
+    glBindTexture(GL_TEXTURE_2D, pyramid.level(0).texture(BlurPyramid::BrightAttachment));
+    m_compositeProgram.set(m_compositeUniforms.bloom, 0);
+    m_compositeProgram.set(m_compositeUniforms.strength, strength / totalWeight);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glUseProgram(0);
+    ShaderProgram::unbind();
     glBindVertexArray(0);
 }
@@ -1,10 +1,12 @@
 #pragma once
 
-#include "Framebuffer.hpp"
+#include "BlurPyramid.hpp"
 #include "ShaderProgram.hpp"
 
 #include <GL/glew.h>
 
+// Dual-filter bloom: a tent upsample that folds each coarser level of the
+// pyramid's bright-pass chain back into the next finer one.
 class BloomRenderer {
 public:
     BloomRenderer() = default;
@@ -13,8 +15,10 @@ public:
     BloomRenderer(const BloomRenderer&) = delete;
     BloomRenderer& operator=(const BloomRenderer&) = delete;
 
+    // Accumulates into the pyramid's bright-pass attachments in place; the
+    // blurred attachments are left untouched for other consumers.
     void render(
-        GLuint sourceTexture,
+        BlurPyramid& pyramid,
         GLuint targetFramebuffer,
         int width,
         int height,
@@ -23,10 +27,14 @@ public:
 private:
     void initialize();
 
-    ShaderProgram m_blurProgram;
+    ShaderProgram m_upsampleProgram;
     ShaderProgram m_compositeProgram;
-    Framebuffer m_ping;
-    Framebuffer m_pong;
+    struct UpsampleUniforms {
+        ShaderProgram::Uniform texture, texel, weight;
+    } m_upsampleUniforms;
+    struct CompositeUniforms {
+        ShaderProgram::Uniform bloom, strength;
+    } m_compositeUniforms;
     GLuint m_quadVao = 0;
     GLuint m_quadVbo = 0;
     bool m_initialized = false;
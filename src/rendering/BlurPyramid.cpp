@@ -0,0 +1,180 @@
+#include "BlurPyramid.hpp"
+
+#include "AssetPaths.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// The chain stops once the short side of a level would drop below this.
+constexpr int MinLevelSize = 16;
+// Above this short side the first level starts at quarter resolution, so a
+// 4K export costs about the same as 1080p and blur radii keep their size.
+constexpr int MaxFirstLevelSize = 720;
+}
+
+BlurPyramid::~BlurPyramid() {
+    if (m_quadVao != 0) glDeleteVertexArrays(1, &m_quadVao);
+    if (m_quadVbo != 0) glDeleteBuffers(1, &m_quadVbo);
+}
+
+void BlurPyramid::initialize() {
+    if (m_initialized) return;
+
+    m_program.load(
+        AssetPaths::shader("quad.vert"),
+        AssetPaths::shader("pyramid_downsample.frag"));
+    m_uniforms = {
+        m_program.uniform("uTexture"),
+        m_program.uniform("uBright"),
+        m_program.uniform("uHalfTexel"),
+        m_program.uniform("uThreshold"),
+        m_program.uniform("uSoftKnee"),
+        m_program.uniform("uPrefilter")};
+    m_upsampleProgram.load(
+        AssetPaths::shader("quad.vert"),
+        AssetPaths::shader("bloom_upsample.frag"));
+    m_upsampleUniforms = {
+        m_upsampleProgram.uniform("uTexture"),
+        m_upsampleProgram.uniform("uTexel"),
+        m_upsampleProgram.uniform("uWeight")};
+
+    constexpr float quadVertices[] = {
+        -1.0f,  1.0f, 0.0f, 1.0f,
+        -1.0f, -1.0f, 0.0f, 0.0f,
+         1.0f, -1.0f, 1.0f, 0.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 1.0f, 0.0f,
+         1.0f,  1.0f, 1.0f, 1.0f
+    };
+
+    glGenVertexArrays(1, &m_quadVao);
+    glGenBuffers(1, &m_quadVbo);
+    glBindVertexArray(m_quadVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
+        reinterpret_cast<void*>(2 * sizeof(float)));
+
+    m_initialized = true;
+}
+
+void BlurPyramid::build(FramebufferPool& pool, GLuint sceneTexture, int width, int height) {
+    build(pool, sceneTexture, width, height, MaxLevels, Region{});
+}
+
+void BlurPyramid::build(
+    FramebufferPool& pool, GLuint sceneTexture, int width, int height,
+    int maxLevels, const Region& region
+) {
+    m_levelCount = 0;
+    if (sceneTexture == 0 || width <= 0 || height <= 0) return;
+    initialize();
+
+    int divisor = 2;
+    while (std::min(width, height) / divisor > MaxFirstLevelSize) divisor *= 2;
+    const int firstShort = std::max(std::min(width, height) / divisor, 1);
+    m_levelCount = std::clamp(
+        1 + static_cast<int>(std::floor(std::log2(static_cast<float>(firstShort) / MinLevelSize))),
+        1, std::clamp(maxLevels, 1, MaxLevels));
+    for (int level = 0; level < m_levelCount; ++level) {
+        m_levels[level] = &pool.acquire(
+            std::max(width / (divisor << level), 1),
+            std::max(height / (divisor << level), 1),
+            Framebuffer::Format::R11G11B10F, 2);
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glBindVertexArray(m_quadVao);
+    m_program.use();
+    m_program.set(m_uniforms.texture, 0);
+    m_program.set(m_uniforms.bright, 1);
+    m_program.set(m_uniforms.threshold, 1.0f);
+    m_program.set(m_uniforms.softKnee, 0.5f);
+
+    // Every downsample reads about two source texels beyond its own, so a
+    // few texels of the coarsest level cover the reach of the whole chain.
+    const bool scissored = region.left > 0.0f || region.bottom > 0.0f ||
+                           region.right < 1.0f || region.top < 1.0f;
+    const float padding = static_cast<float>(4 * (divisor << (m_levelCount - 1)));
+    if (scissored) glEnable(GL_SCISSOR_TEST);
+
+    // Only the first level applies the bright-pass threshold; later levels
+    // just average the previous level of each chain.
+    GLuint blurInput = sceneTexture;
+    GLuint brightInput = sceneTexture;
+    for (int level = 0; level < m_levelCount; ++level) {
+        Framebuffer& destination = *m_levels[level];
+        destination.bind();
+        glViewport(0, 0, destination.width(), destination.height());
+        if (scissored) {
+            const float texel = static_cast<float>(divisor << level);
+            const int left = std::max(static_cast<int>(std::floor((region.left * width - padding) / texel)), 0);
+            const int bottom = std::max(static_cast<int>(std::floor((region.bottom * height - padding) / texel)), 0);
+            const int right = std::min(static_cast<int>(std::ceil((region.right * width + padding) / texel)), destination.width());
+            const int top = std::min(static_cast<int>(std::ceil((region.top * height + padding) / texel)), destination.height());
+            glScissor(left, bottom, std::max(right - left, 0), std::max(top - bottom, 0));
+        }
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, brightInput);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, blurInput);
+        m_program.set(
+            m_uniforms.halfTexel,
+            0.5f / static_cast<float>(destination.width()),
+            0.5f / static_cast<float>(destination.height()));
+        m_program.set(m_uniforms.prefilter, level == 0 ? 1 : 0);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        blurInput = destination.texture(BlurAttachment);
+        brightInput = destination.texture(BrightAttachment);
+    }
+
+    if (scissored) glDisable(GL_SCISSOR_TEST);
+    ShaderProgram::unbind();
+    glBindVertexArray(0);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+GLuint BlurPyramid::blurred(int level) const noexcept {
+    if (m_levelCount == 0) return 0;
+    return m_levels[std::clamp(level, 0, m_levelCount - 1)]->texture(BlurAttachment);
+}
+
+GLuint BlurPyramid::upsampledBlur(FramebufferPool& pool, int level) {
+    if (m_levelCount == 0) return 0;
+    level = std::clamp(level, 0, m_levelCount - 1);
+    if (level == 0) return blurred(0);
+
+    const Framebuffer& source = *m_levels[level];
+    const Framebuffer& finer = *m_levels[level - 1];
+    Framebuffer& destination = pool.acquire(
+        finer.width(), finer.height(), Framebuffer::Format::R11G11B10F);
+    destination.bind();
+    glViewport(0, 0, destination.width(), destination.height());
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glBindVertexArray(m_quadVao);
+    m_upsampleProgram.use();
+    m_upsampleProgram.set(m_upsampleUniforms.texture, 0);
+    m_upsampleProgram.set(m_upsampleUniforms.weight, 1.0f);
+    m_upsampleProgram.set(
+        m_upsampleUniforms.texel,
+        1.0f / static_cast<float>(source.width()),
+        1.0f / static_cast<float>(source.height()));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, source.texture(BlurAttachment));
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    ShaderProgram::unbind();
+    glBindVertexArray(0);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    return destination.texture();
+}
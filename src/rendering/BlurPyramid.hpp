@@ -0,0 +1,65 @@
+#pragma once
+
+#include "FramebufferPool.hpp"
+#include "ShaderProgram.hpp"
+
+#include <GL/glew.h>
+#include <array>
+
+// Per-frame downsample chain of the HDR scene shared by bloom and the
+// blurred lyrics band. Each level carries two attachments written by the
+// same pass: the plain blurred scene and the bloom bright-pass chain.
+class BlurPyramid {
+public:
+    static constexpr int MaxLevels = 6;
+    static constexpr int BlurAttachment = 0;
+    static constexpr int BrightAttachment = 1;
+
+    BlurPyramid() = default;
+    ~BlurPyramid();
+
+    BlurPyramid(const BlurPyramid&) = delete;
+    BlurPyramid& operator=(const BlurPyramid&) = delete;
+
+    // Part of the scene in texture coordinates that consumers will sample.
+    struct Region {
+        float left = 0.0f;
+        float bottom = 0.0f;
+        float right = 1.0f;
+        float top = 1.0f;
+    };
+
+    // Levels are borrowed from the pool and stay valid until its next frame.
+    void build(FramebufferPool& pool, GLuint sceneTexture, int width, int height);
+    // A partial region scissors every pass to it plus the filter footprint
+    // of the remaining levels; texels outside it are left undefined.
+    void build(
+        FramebufferPool& pool, GLuint sceneTexture, int width, int height,
+        int maxLevels, const Region& region);
+
+    [[nodiscard]] int levelCount() const noexcept { return m_levelCount; }
+    [[nodiscard]] Framebuffer& level(int index) const { return *m_levels[index]; }
+    // Plain blurred scene at the given level, clamped to the built range.
+    [[nodiscard]] GLuint blurred(int level) const noexcept;
+    // Tent-upsamples the blurred scene at the given level to the next finer
+    // level's size, so consumers stretching it get the same blur radius
+    // without bilinear blocks. The target is borrowed from the pool.
+    GLuint upsampledBlur(FramebufferPool& pool, int level);
+
+private:
+    void initialize();
+
+    ShaderProgram m_program;
+    struct Uniforms {
+        ShaderProgram::Uniform texture, bright, halfTexel, threshold, softKnee, prefilter;
+    } m_uniforms;
+    ShaderProgram m_upsampleProgram;
+    struct UpsampleUniforms {
+        ShaderProgram::Uniform texture, texel, weight;
+    } m_upsampleUniforms;
+    std::array<Framebuffer*, MaxLevels> m_levels{};
+    int m_levelCount = 0;
+    GLuint m_quadVao = 0;
+    GLuint m_quadVbo = 0;
+    bool m_initialized = false;
+};
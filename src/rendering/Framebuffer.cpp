@@ -1,32 +1,52 @@
 #include "Framebuffer.hpp"
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+GLint internalFormat(Framebuffer::Format format) {
+    switch (format) {
+        case Framebuffer::Format::Rgba8: return GL_RGBA8;
+        case Framebuffer::Format::R11G11B10F: return GL_R11F_G11F_B10F;
+        case Framebuffer::Format::Rgba16F: break;
+    }
+    return GL_RGBA16F;
+}
+}
+
 Framebuffer::~Framebuffer() {
     reset();
 }
 
-void Framebuffer::resize(int width, int height) {
-    if (m_width == width && m_height == height && ready()) return;
+void Framebuffer::resize(int width, int height, Format format, int colorAttachments) {
+    colorAttachments = std::clamp(colorAttachments, 1, MaxColorAttachments);
+    if (m_width == width && m_height == height && m_format == format &&
+        m_colorAttachments == colorAttachments && ready()) return;
 
     reset();
     m_width = width;
     m_height = height;
+    m_format = format;
+    m_colorAttachments = colorAttachments;
 
     glGenFramebuffers(1, &m_id);
     glBindFramebuffer(GL_FRAMEBUFFER, m_id);
 
-    glGenTextures(1, &m_texture);
-    glBindTexture(GL_TEXTURE_2D, m_texture);
-    glTexImage2D(
-        GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0,
-        GL_RGBA, GL_HALF_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glFramebufferTexture2D(
-        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+    glGenTextures(colorAttachments, m_textures.data());
+    for (int attachment = 0; attachment < colorAttachments; ++attachment) {
+        glBindTexture(GL_TEXTURE_2D, m_textures[attachment]);
+        glTexImage2D(
+            GL_TEXTURE_2D, 0, internalFormat(format), width, height, 0,
+            GL_RGBA, format == Format::Rgba8 ? GL_UNSIGNED_BYTE : GL_HALF_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + attachment, GL_TEXTURE_2D,
+            m_textures[attachment], 0);
+    }
+    setDrawBuffers(-1);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         std::cerr << "Framebuffer is not complete" << std::endl;
@@ -39,6 +59,23 @@ void Framebuffer::resize(int width, int height) {
 
 void Framebuffer::bind() const {
     glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    if (m_drawAttachment != -1) setDrawBuffers(-1);
+}
+
+void Framebuffer::bindAttachment(int index) const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    if (m_drawAttachment != index) setDrawBuffers(index);
+}
+
+void Framebuffer::setDrawBuffers(int only) const {
+    std::array<GLenum, MaxColorAttachments> buffers{};
+    for (int attachment = 0; attachment < m_colorAttachments; ++attachment) {
+        buffers[attachment] = only < 0 || only == attachment
+            ? static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + attachment)
+            : static_cast<GLenum>(GL_NONE);
+    }
+    glDrawBuffers(m_colorAttachments, buffers.data());
+    m_drawAttachment = only;
 }
 
 void Framebuffer::unbind() {
@@ -47,9 +84,12 @@ void Framebuffer::unbind() {
 
 void Framebuffer::reset() noexcept {
     if (m_id != 0) glDeleteFramebuffers(1, &m_id);
-    if (m_texture != 0) glDeleteTextures(1, &m_texture);
+    for (GLuint& texture : m_textures) {
+        if (texture != 0) glDeleteTextures(1, &texture);
+        texture = 0;
+    }
     m_id = 0;
-    m_texture = 0;
     m_width = 0;
     m_height = 0;
+    m_drawAttachment = -1;
 }
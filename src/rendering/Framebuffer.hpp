@@ -1,28 +1,50 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <array>
 
 class Framebuffer {
 public:
+    static constexpr int MaxColorAttachments = 2;
+
+    // Storage per target: Rgba16F for accumulated energy that decays in
+    // small steps, R11G11B10F for HDR colour that needs range but no alpha
+    // (half the bandwidth), Rgba8 for LDR layers.
+    enum class Format { Rgba8, Rgba16F, R11G11B10F };
+
     Framebuffer() = default;
     ~Framebuffer();
 
     Framebuffer(const Framebuffer&) = delete;
     Framebuffer& operator=(const Framebuffer&) = delete;
 
-    void resize(int width, int height);
+    // Reallocates only when the size, format or attachment count
+    // changes. Every attachment shares the same format.
+    void resize(int width, int height, Format format = Format::Rgba16F, int colorAttachments = 1);
+    // Binds with all attachments enabled as draw buffers.
     void bind() const;
+    // Binds so that draws only reach the given attachment.
+    void bindAttachment(int index) const;
     static void unbind();
     void reset() noexcept;
 
     [[nodiscard]] bool ready() const noexcept { return m_id != 0; }
-    [[nodiscard]] GLuint texture() const noexcept { return m_texture; }
+    [[nodiscard]] GLuint texture(int attachment = 0) const noexcept { return m_textures[attachment]; }
     [[nodiscard]] int width() const noexcept { return m_width; }
     [[nodiscard]] int height() const noexcept { return m_height; }
+    [[nodiscard]] Format format() const noexcept { return m_format; }
+    [[nodiscard]] int colorAttachments() const noexcept { return m_colorAttachments; }
 
 private:
+    void setDrawBuffers(int only) const;
+
     GLuint m_id = 0;
-    GLuint m_texture = 0;
+    std::array<GLuint, MaxColorAttachments> m_textures{};
     int m_width = 0;
     int m_height = 0;
+    Format m_format = Format::Rgba16F;
+    int m_colorAttachments = 1;
+    // Draw-buffer selection is framebuffer state, so it is only respecified
+    // when bindAttachment() changed it.
+    mutable int m_drawAttachment = -1;
 };
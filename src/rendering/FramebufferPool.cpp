@@ -0,0 +1,46 @@
+#include "FramebufferPool.hpp"
+
+#include <algorithm>
+
+void FramebufferPool::beginFrame() {
+    ++m_frame;
+    m_entries.erase(
+        std::remove_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+            return m_frame - entry.lastUsedFrame > MaxIdleFrames;
+        }),
+        m_entries.end());
+    for (auto& entry : m_entries) entry.inUse = false;
+}
+
+Framebuffer& FramebufferPool::acquire(
+    int width, int height, Framebuffer::Format format, int colorAttachments
+) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    auto match = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+        return !entry.inUse && entry.target->width() == width &&
+               entry.target->height() == height &&
+               entry.target->format() == format &&
+               entry.target->colorAttachments() == colorAttachments;
+    });
+    if (match == m_entries.end()) {
+        Entry entry;
+        entry.target = std::make_unique<Framebuffer>();
+        entry.target->resize(width, height, format, colorAttachments);
+        m_entries.push_back(std::move(entry));
+        match = m_entries.end() - 1;
+    }
+    match->inUse = true;
+    match->lastUsedFrame = m_frame;
+    return *match->target;
+}
+
+void FramebufferPool::release(const Framebuffer& target) {
+    for (auto& entry : m_entries) {
+        if (entry.target.get() == &target) entry.inUse = false;
+    }
+}
+
+void FramebufferPool::clear() {
+    m_entries.clear();
+}
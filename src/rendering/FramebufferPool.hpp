@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Framebuffer.hpp"
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Shared store of transient render targets keyed by size, format and
+// attachment count.
+// Targets handed out during a frame stay reserved until the next
+// beginFrame(), or until released early so a later pass can reuse them.
+// Entries idle for MaxIdleFrames are freed, which lets a 4K export and a
+// 1080p preview interleave without reallocating either set of targets.
+class FramebufferPool {
+public:
+    static constexpr std::uint64_t MaxIdleFrames = 120;
+
+    FramebufferPool() = default;
+    FramebufferPool(const FramebufferPool&) = delete;
+    FramebufferPool& operator=(const FramebufferPool&) = delete;
+
+    void beginFrame();
+    Framebuffer& acquire(
+        int width, int height,
+        Framebuffer::Format format = Framebuffer::Format::Rgba16F,
+        int colorAttachments = 1);
+    void release(const Framebuffer& target);
+    void clear();
+
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+
+private:
+    struct Entry {
+        std::unique_ptr<Framebuffer> target;
+        std::uint64_t lastUsedFrame = 0;
+        bool inUse = false;
+    };
+
+    std::vector<Entry> m_entries;
+    std::uint64_t m_frame = 0;
+};
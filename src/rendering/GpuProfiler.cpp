@@ -0,0 +1,166 @@
+#include "GpuProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+GpuProfiler::Scope::Scope(GpuProfiler* profiler, const std::string& name) {
+    if (!profiler || !profiler->m_recording) return;
+    m_profiler = profiler;
+    m_profiler->begin(name);
+}
+
+GpuProfiler::Scope::Scope(GpuProfiler* profiler, std::uint64_t key, const std::string& label) {
+    if (!profiler || !profiler->m_recording) return;
+    m_profiler = profiler;
+    m_profiler->begin(label.empty() ? "#" + std::to_string(key) : label, key);
+}
+
+GpuProfiler::Scope::~Scope() {
+    if (m_profiler) m_profiler->end();
+}
+
+GpuProfiler::~GpuProfiler() {
+    clear();
+}
+
+void GpuProfiler::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    if (!enabled) clear();
+}
+
+void GpuProfiler::clear() {
+    for (auto& frame : m_frames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+        frame = Frame{};
+    }
+    m_open.clear();
+    m_passes.clear();
+    m_recording = false;
+    m_resolvedFrames = 0;
+    m_frameMs = 0.0f;
+}
+
+void GpuProfiler::beginFrame() {
+    if (!m_enabled) return;
+    m_current = (m_current + 1) % FramesInFlight;
+    Frame& frame = m_frames[m_current];
+    if (frame.recorded) resolve(frame);
+    frame.usedQueries = 0;
+    frame.samples.clear();
+    frame.recorded = false;
+    m_open.clear();
+    m_recording = true;
+    begin("Frame");
+}
+
+void GpuProfiler::endFrame() {
+    if (!m_recording) return;
+    while (!m_open.empty()) end();
+    m_frames[m_current].recorded = true;
+    m_recording = false;
+}
+
+size_t GpuProfiler::recordTimestamp() {
+    Frame& frame = m_frames[m_current];
+    if (frame.usedQueries == frame.queries.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+    glQueryCounter(frame.queries[frame.usedQueries], GL_TIMESTAMP);
+    return frame.usedQueries++;
+}
+
+void GpuProfiler::begin(const std::string& name, std::uint64_t key) {
+    if (!m_recording) return;
+    Frame& frame = m_frames[m_current];
+    Sample sample;
+    sample.name = name;
+    sample.key = key;
+    sample.depth = static_cast<int>(m_open.size());
+    sample.startQuery = recordTimestamp();
+    sample.endQuery = sample.startQuery;
+    frame.samples.push_back(std::move(sample));
+    m_open.push_back(frame.samples.size() - 1);
+}
+
+void GpuProfiler::end() {
+    if (!m_recording || m_open.empty()) return;
+    const size_t index = m_open.back();
+    m_open.pop_back();
+    const size_t query = recordTimestamp();
+    m_frames[m_current].samples[index].endQuery = query;
+}
+
+void GpuProfiler::resolve(Frame& frame) {
+    // The last timestamp finishes last; if it is not ready, skip the frame
+    // rather than stall.
+    if (frame.usedQueries == 0) return;
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+
+    std::vector<GLuint64> timestamps(frame.usedQueries);
+    for (size_t i = 0; i < frame.usedQueries; ++i) {
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+    }
+
+    std::vector<float> frameTimes(m_passes.size(), 0.0f);
+    for (const auto& sample : frame.samples) {
+        const float ms = static_cast<float>(timestamps[sample.endQuery] - timestamps[sample.startQuery]) / 1.0e6f;
+        auto pass = std::find_if(m_passes.begin(), m_passes.end(), [&](const PassStats& stats) {
+            if (stats.key != sample.key || stats.depth != sample.depth) return false;
+            return sample.key != 0 || stats.name == sample.name;
+        });
+        if (pass == m_passes.end()) {
+            PassStats stats;
+            stats.key = sample.key;
+            stats.depth = sample.depth;
+            stats.history.assign(std::min<std::uint64_t>(m_resolvedFrames, HistoryLength), 0.0f);
+            m_passes.push_back(std::move(stats));
+            frameTimes.push_back(0.0f);
+            pass = m_passes.end() - 1;
+        }
+        // Repeated scopes (several offline frames in one tick) accumulate.
+        frameTimes[static_cast<size_t>(pass - m_passes.begin())] += ms;
+        pass->name = sample.name;
+        pass->lastSeenFrame = m_resolvedFrames;
+    }
+
+    ++m_resolvedFrames;
+    for (size_t i = 0; i < m_passes.size(); ++i) {
+        auto& pass = m_passes[i];
+        pass.lastMs = frameTimes[i];
+        pass.averageMs += (pass.lastMs - pass.averageMs) * 0.05f;
+        if (pass.history.size() == HistoryLength) pass.history.erase(pass.history.begin());
+        pass.history.push_back(pass.lastMs);
+        pass.maxMs = *std::max_element(pass.history.begin(), pass.history.end());
+    }
+    // Passes absent for a whole history window (removed layers, disabled
+    // effects) leave the table.
+    m_passes.erase(std::remove_if(m_passes.begin(), m_passes.end(), [&](const PassStats& pass) {
+        return m_resolvedFrames - pass.lastSeenFrame > HistoryLength;
+    }), m_passes.end());
+    if (!m_passes.empty()) m_frameMs = m_passes.front().lastMs;
+}
+
+bool GpuProfiler::exportCsv(const std::filesystem::path& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "frame,pass,depth,ms\n";
+    size_t frames = 0;
+    for (const auto& pass : m_passes) frames = std::max(frames, pass.history.size());
+    const std::uint64_t firstFrame = m_resolvedFrames - frames;
+    for (size_t frame = 0; frame < frames; ++frame) {
+        for (const auto& pass : m_passes) {
+            const size_t offset = frames - pass.history.size();
+            if (frame < offset) continue;
+            file << firstFrame + frame << ",\"" << pass.name << "\"," << pass.depth << ','
+                 << pass.history[frame - offset] << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// GPU pass timings from GL_TIMESTAMP query pairs. Scopes may nest (a layer
+// draw inside the persistence pass), which GL_TIME_ELAPSED cannot do.
+// Queries are recycled over FramesInFlight frames and only read once the
+// driver reports them available, so the CPU never waits on the GPU.
+class GpuProfiler {
+public:
+    static constexpr int FramesInFlight = 4;
+    static constexpr size_t HistoryLength = 240;
+
+    struct PassStats {
+        std::string name;
+        // Non-zero for scopes keyed by an id (layers); the name is then only
+        // a label and follows renames.
+        std::uint64_t key = 0;
+        int depth = 0;
+        float lastMs = 0.0f;
+        float averageMs = 0.0f;
+        float maxMs = 0.0f;
+        // Oldest first, one entry per resolved frame; 0 when the pass did not run.
+        std::vector<float> history;
+        std::uint64_t lastSeenFrame = 0;
+    };
+
+    // Times everything between construction and destruction. A null or
+    // disabled profiler makes the scope a no-op.
+    class Scope {
+    public:
+        Scope(GpuProfiler* profiler, const std::string& name);
+        Scope(GpuProfiler* profiler, std::uint64_t key, const std::string& label);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GpuProfiler* m_profiler = nullptr;
+    };
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool enabled() const noexcept { return m_enabled; }
+
+    // Resolves the oldest frame in flight and starts recording a new one.
+    void beginFrame();
+    void endFrame();
+    void begin(const std::string& name, std::uint64_t key = 0);
+    void end();
+
+    [[nodiscard]] const std::vector<PassStats>& passes() const noexcept { return m_passes; }
+    [[nodiscard]] float frameMs() const noexcept { return m_frameMs; }
+    // Long-format history: one "frame,pass,depth,ms" row per pass per frame.
+    bool exportCsv(const std::filesystem::path& path) const;
+
+private:
+    struct Sample {
+        std::string name;
+        std::uint64_t key = 0;
+        int depth = 0;
+        size_t startQuery = 0;
+        size_t endQuery = 0;
+    };
+
+    struct Frame {
+        std::vector<GLuint> queries;
+        size_t usedQueries = 0;
+        std::vector<Sample> samples;
+        bool recorded = false;
+    };
+
+    size_t recordTimestamp();
+    void resolve(Frame& frame);
+    void clear();
+
+    std::array<Frame, FramesInFlight> m_frames;
+    int m_current = 0;
+    bool m_recording = false;
+    bool m_enabled = false;
+    std::vector<size_t> m_open;
+    std::vector<PassStats> m_passes;
+    std::uint64_t m_resolvedFrames = 0;
+    float m_frameMs = 0.0f;
+};
@@ -7,6 +7,11 @@
 #include <regex>
 #include <sstream>
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define OVERLAY_SSE 1
+#endif
+
 namespace {
 std::string trim(std::string value) {
     const auto first = value.find_first_not_of(" \t\r\n");
@@ -15,6 +20,22 @@ std::string trim(std::string value) {
     return value.substr(first, last - first + 1);
 }
 
+float rangeMax(const float* values, size_t count) {
+    float result = 0.0f;
+    size_t i = 0;
+#ifdef OVERLAY_SSE
+    if (count >= 4) {
+        __m128 peak = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) peak = _mm_max_ps(peak, _mm_loadu_ps(values + i));
+        peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+        peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, 1));
+        result = _mm_cvtss_f32(peak);
+    }
+#endif
+    for (; i < count; ++i) result = std::max(result, values[i]);
+    return result;
+}
+
 void drawCentered(
     Visualizer& visualizer,
     const std::string& text,
@@ -125,23 +146,20 @@ void OverlayPresetRenderer::renderSpectrum(
         std::clamp(lineThickness, 0.0005f, 0.02f), 0.0f, color);
     if (fft.empty()) return;
 
+    const float amplitudeCap = std::clamp(requestedAmplitudeCap, 0.05f, 8.0f);
+    std::vector<float> heights(static_cast<size_t>(barCount), 0.0f);
     for (int i = 0; i < barCount; ++i) {
         const size_t begin = static_cast<size_t>(i) * fft.size() / barCount;
-        const size_t finish = std::max(begin + 1, static_cast<size_t>(i + 1) * fft.size() / barCount);
-        float magnitude = 0.0f;
-        for (size_t j = begin; j < std::min(finish, fft.size()); ++j) {
-            magnitude = std::max(magnitude, fft[j]);
-        }
-        const float amplitudeCap = std::clamp(requestedAmplitudeCap, 0.05f, 8.0f);
+        const size_t finish = std::min(
+            std::max(begin + 1, static_cast<size_t>(i + 1) * fft.size() / barCount), fft.size());
+        const float magnitude = begin < finish ? rangeMax(fft.data() + begin, finish - begin) : 0.0f;
         const float height =
             std::clamp(magnitude * gain, 0.0f, amplitudeCap) * maxHeight;
-        if (height < 0.002f) continue;
-        const float x = left + (static_cast<float>(i) + 0.5f) * cell;
-        const float y = baselineY + direction * height;
-        visualizer.drawRoundedRect(
-            x, y, cell * 0.5f * std::clamp(requestedBarWidth, 0.05f, 1.0f),
-            height, 0.0f, color);
+        heights[static_cast<size_t>(i)] = height < 0.002f ? 0.0f : height;
     }
+    visualizer.drawBarStrip(
+        heights, left, cell, cell * 0.5f * std::clamp(requestedBarWidth, 0.05f, 1.0f),
+        baselineY, direction, color);
 }
 
 void OverlayPresetRenderer::render(
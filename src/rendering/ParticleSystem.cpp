@@ -11,13 +11,11 @@ ParticleSystem::ParticleSystem() {
 
 ParticleSystem::~ParticleSystem() {
     glDeleteVertexArrays(1, &m_vao);
-    glDeleteBuffers(1, &m_vbo);
 }
 
 void ParticleSystem::init() {
     initShaders();
     glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
     
     // Enable point size control in vertex shader
     glEnable(GL_PROGRAM_POINT_SIZE);
@@ -72,7 +70,7 @@ void ParticleSystem::spawnParticles(int count) {
     }
 }
 
-void ParticleSystem::render() {
+void ParticleSystem::render(StreamingBuffer& stream) {
     if (m_particles.empty()) return;
 
     std::vector<float> vertices;
@@ -87,8 +85,7 @@ void ParticleSystem::render() {
     }
 
     glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STREAM_DRAW);
+    const GLint first = stream.upload(vertices.data(), vertices.size() * sizeof(float), 7 * sizeof(float));
 
     // Position
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
@@ -105,8 +102,8 @@ void ParticleSystem::render() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST); // Ensure no z-fighting
     
-    glUseProgram(m_shaderProgram);
-    glDrawArrays(GL_POINTS, 0, m_particles.size());
+    m_shaderProgram.use();
+    glDrawArrays(GL_POINTS, first, m_particles.size());
     
     glDisable(GL_PROGRAM_POINT_SIZE);
 }
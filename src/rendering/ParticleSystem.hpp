@@ -2,6 +2,7 @@
 #define PARTICLESYSTEM_HPP
 
 #include "ShaderProgram.hpp"
+#include "StreamingBuffer.hpp"
 #include <GL/glew.h>
 #include <vector>
 #include <glm/glm.hpp>
@@ -21,7 +22,7 @@ public:
 
     void init();
     void update(float deltaTime, bool beatDetected);
-    void render();
+    void render(StreamingBuffer& stream);
 
     // Configuration
     void setParticleCount(int count) { m_maxParticles = count; }
@@ -32,7 +33,7 @@ public:
 
 private:
     std::vector<Particle> m_particles;
-    GLuint m_vao, m_vbo;
+    GLuint m_vao;
     ShaderProgram m_shaderProgram;
 
     // Settings
@@ -0,0 +1,119 @@
+#include "PhosphorAccumulator.hpp"
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define PHOSPHOR_SSE 1
+#endif
+
+namespace {
+constexpr float StepPixels = 0.5f;
+
+void scale(float* values, size_t count, float factor) {
+    size_t i = 0;
+#ifdef PHOSPHOR_SSE
+    const __m128 multiplier = _mm_set1_ps(factor);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(values + i, _mm_mul_ps(_mm_loadu_ps(values + i), multiplier));
+    }
+#endif
+    for (; i < count; ++i) values[i] *= factor;
+}
+}
+
+void PhosphorAccumulator::resize(int width, int height) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if (width == m_width && height == m_height) return;
+    m_width = width;
+    m_height = height;
+    m_buffer.assign(static_cast<size_t>(width) * height, 0.0f);
+}
+
+void PhosphorAccumulator::clear() { std::fill(m_buffer.begin(), m_buffer.end(), 0.0f); }
+
+void PhosphorAccumulator::collectSplats(const XYTraceBatch& trace, const Beam& beam) {
+    m_splats.clear();
+    // Same aspect compensation as Visualizer::renderXY so circles stay round.
+    const float scale = 0.5f * static_cast<float>(m_height);
+    const float centerX = 0.5f * static_cast<float>(m_width);
+    const float centerY = 0.5f * static_cast<float>(m_height);
+    const float density = std::clamp(beam.densityEffect, 0.0f, 1.0f);
+    for (size_t i = 1; i < trace.points.size(); ++i) {
+        const XYTracePoint& a = trace.points[i - 1];
+        const XYTracePoint& b = trace.points[i];
+        if (b.breakBefore) continue;
+        const float ax = centerX + a.x * scale, ay = centerY + a.y * scale;
+        const float bx = centerX + b.x * scale, by = centerY + b.y * scale;
+        const float length = std::hypot(bx - ax, by - ay);
+        const int steps = std::max(1, static_cast<int>(std::ceil(length / StepPixels)));
+        const float energy = (1.0f - density) * length + density;
+        for (int step = 0; step < steps; ++step) {
+            const float t = (static_cast<float>(step) + 0.5f) / static_cast<float>(steps);
+            const float intensity = a.intensity + (b.intensity - a.intensity) * t;
+            m_splats.push_back({ax + (bx - ax) * t, ay + (by - ay) * t, intensity * energy / steps});
+        }
+    }
+}
+
+void PhosphorAccumulator::processRows(int firstRow, int lastRow, float sigma, float decayFactor) {
+    scale(m_buffer.data() + static_cast<size_t>(firstRow) * m_width,
+          static_cast<size_t>(lastRow - firstRow) * m_width, decayFactor);
+
+    // A line of unit energy per pixel peaks near 1 across its width.
+    const float gain = std::sqrt(2.0f * 3.14159265f) * sigma;
+    const float inverse = 1.0f / (2.0f * sigma * sigma);
+    const int radius = static_cast<int>(std::ceil(3.0f * sigma));
+    std::vector<float> weightsX(static_cast<size_t>(radius * 2 + 1));
+    std::vector<float> weightsY(static_cast<size_t>(radius * 2 + 1));
+    for (const Splat& splat : m_splats) {
+        const int centerRow = static_cast<int>(std::floor(splat.y));
+        const int rowBegin = std::max(centerRow - radius, firstRow);
+        const int rowEnd = std::min(centerRow + radius + 1, lastRow);
+        if (rowBegin >= rowEnd) continue;
+        const int centerColumn = static_cast<int>(std::floor(splat.x));
+        const int columnBegin = std::max(centerColumn - radius, 0);
+        const int columnEnd = std::min(centerColumn + radius + 1, m_width);
+        if (columnBegin >= columnEnd) continue;
+
+        float sumX = 0.0f, sumY = 0.0f;
+        for (int offset = -radius; offset <= radius; ++offset) {
+            const float dx = static_cast<float>(centerColumn + offset) + 0.5f - splat.x;
+            const float dy = static_cast<float>(centerRow + offset) + 0.5f - splat.y;
+            weightsX[offset + radius] = std::exp(-dx * dx * inverse);
+            weightsY[offset + radius] = std::exp(-dy * dy * inverse);
+            sumX += weightsX[offset + radius];
+            sumY += weightsY[offset + radius];
+        }
+        const float energy = splat.energy * gain / (sumX * sumY);
+        for (int row = rowBegin; row < rowEnd; ++row) {
+            const float rowEnergy = energy * weightsY[row - centerRow + radius];
+            float* target = m_buffer.data() + static_cast<size_t>(row) * m_width;
+            for (int column = columnBegin; column < columnEnd; ++column) {
+                target[column] += rowEnergy * weightsX[column - centerColumn + radius];
+            }
+        }
+    }
+}
+
+void PhosphorAccumulator::accumulate(
+    const XYTraceBatch& trace, const Beam& beam, float decayFactor, WorkerPool* pool
+) {
+    if (m_buffer.empty()) return;
+    collectSplats(trace, beam);
+    const float sigma = std::max(beam.widthPixels * 0.5f, 0.5f);
+    decayFactor = std::clamp(decayFactor, 0.0f, 1.0f);
+
+    // Each band owns its rows, so workers never write the same pixel.
+    const int bands = pool ? std::min(static_cast<int>(pool->threadCount()) + 1, m_height) : 1;
+    auto band = [&](size_t index) {
+        const int first = static_cast<int>(index) * m_height / bands;
+        const int last = static_cast<int>(index + 1) * m_height / bands;
+        processRows(first, last, sigma, decayFactor);
+    };
+    if (pool && bands > 1) pool->parallelFor(static_cast<size_t>(bands), band);
+    else band(0);
+}
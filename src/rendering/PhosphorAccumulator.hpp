@@ -0,0 +1,49 @@
+#pragma once
+
+#include "XYOscilloscopeTypes.hpp"
+
+#include <vector>
+
+class WorkerPool;
+
+// CPU hit-map renderer for XY traces. Beam energy is splatted with a
+// Gaussian profile into a float buffer that decays exponentially, so the
+// result does not depend on GPU line quality and needs no GL context.
+class PhosphorAccumulator {
+public:
+    struct Beam {
+        float widthPixels = 2.0f;
+        // 0 spreads energy evenly along the path; 1 gives every sample
+        // interval the same energy, so slow beam movement glows brighter.
+        float densityEffect = 0.0f;
+    };
+
+    // Rows are bottom-up to match GL texture uploads. Resizing clears.
+    void resize(int width, int height);
+    void clear();
+
+    // Multiplies the buffer by decayFactor, then deposits the trace. Rows
+    // are split into bands across the pool when one is given.
+    void accumulate(
+        const XYTraceBatch& trace, const Beam& beam, float decayFactor,
+        WorkerPool* pool = nullptr);
+
+    [[nodiscard]] const std::vector<float>& data() const noexcept { return m_buffer; }
+    [[nodiscard]] int width() const noexcept { return m_width; }
+    [[nodiscard]] int height() const noexcept { return m_height; }
+
+private:
+    struct Splat {
+        float x = 0.0f;
+        float y = 0.0f;
+        float energy = 0.0f;
+    };
+
+    void collectSplats(const XYTraceBatch& trace, const Beam& beam);
+    void processRows(int firstRow, int lastRow, float sigma, float decayFactor);
+
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<float> m_buffer;
+    std::vector<Splat> m_splats;
+};
@@ -0,0 +1,117 @@
+#include "PolyphaseUpsampler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define POLYPHASE_SSE 1
+#endif
+
+namespace {
+constexpr int Taps = PolyphaseUpsampler::TapsPerPhase;
+
+// Banks are stored phase-major with taps reversed, so each output is a dot
+// product with a contiguous window of the most recent inputs.
+std::vector<float> buildBank(int factor) {
+    const int length = factor * Taps;
+    const double center = length / 2 - 1;
+    const double cutoff = 0.9 / factor;
+    constexpr double pi = 3.14159265358979323846;
+    std::vector<double> prototype(static_cast<size_t>(length), 0.0);
+    for (int i = 0; i < length - 1; ++i) {
+        const double t = i - center;
+        const double sinc = t == 0.0 ? 1.0 : std::sin(pi * cutoff * t) / (pi * cutoff * t);
+        const double phase = 2.0 * pi * i / (length - 2);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        prototype[static_cast<size_t>(i)] = sinc * window;
+    }
+
+    std::vector<float> bank(static_cast<size_t>(length));
+    for (int p = 0; p < factor; ++p) {
+        // Unity gain per phase keeps DC flat between the original samples.
+        double sum = 0.0;
+        for (int k = 0; k < Taps; ++k) sum += prototype[static_cast<size_t>(p + k * factor)];
+        for (int j = 0; j < Taps; ++j) {
+            const double tap = prototype[static_cast<size_t>(p + (Taps - 1 - j) * factor)];
+            bank[static_cast<size_t>(p * Taps + j)] = static_cast<float>(tap / sum);
+        }
+    }
+    return bank;
+}
+
+const float* bankFor(int factor) {
+    static const auto banks = [] {
+        std::array<std::vector<float>, PolyphaseUpsampler::MaxFactor + 1> built;
+        for (int factor = 2; factor <= PolyphaseUpsampler::MaxFactor; ++factor) built[factor] = buildBank(factor);
+        return built;
+    }();
+    return banks[static_cast<size_t>(factor)].data();
+}
+
+inline float dot(const float* taps, const float* window) {
+#ifdef POLYPHASE_SSE
+    __m128 sum = _mm_mul_ps(_mm_loadu_ps(taps), _mm_loadu_ps(window));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + 4), _mm_loadu_ps(window + 4)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + 8), _mm_loadu_ps(window + 8)));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + 12), _mm_loadu_ps(window + 12)));
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    float sum = 0.0f;
+    for (int j = 0; j < Taps; ++j) sum += taps[j] * window[j];
+    return sum;
+#endif
+}
+
+static_assert(Taps == 16, "dot() is unrolled for 16 taps");
+}
+
+void PolyphaseUpsampler::setFactor(int factor) {
+    factor = std::clamp(factor, 1, MaxFactor);
+    if (factor == m_factor && (factor == 1 || m_bank)) return;
+    m_factor = factor;
+    m_bank = factor > 1 ? bankFor(factor) : nullptr;
+    reset();
+}
+
+void PolyphaseUpsampler::reset() { m_history.clear(); }
+
+void PolyphaseUpsampler::process(const float* input, size_t count, std::vector<float>& output) {
+    if (count == 0) return;
+    if (m_factor == 1) {
+        output.insert(output.end(), input, input + count);
+        return;
+    }
+    if (m_history.empty()) m_history.assign(Taps - 1, input[0]);
+
+    m_window.assign(m_history.begin(), m_history.end());
+    m_window.insert(m_window.end(), input, input + count);
+    const size_t first = output.size();
+    output.resize(first + count * static_cast<size_t>(m_factor));
+    float* out = output.data() + first;
+    for (size_t n = 0; n < count; ++n) {
+        const float* window = m_window.data() + n;
+        for (int p = 0; p < m_factor; ++p) *out++ = dot(m_bank + p * Taps, window);
+    }
+    m_history.assign(m_window.end() - (Taps - 1), m_window.end());
+}
+
+void PolyphaseUpsampler::processBlock(const float* input, size_t count, std::vector<float>& output) {
+    if (count == 0) return;
+    if (m_factor == 1) {
+        output.insert(output.end(), input, input + count);
+        return;
+    }
+    reset();
+    std::vector<float> padded(input, input + count);
+    padded.insert(padded.end(), StreamDelay, input[count - 1]);
+    std::vector<float> streamed;
+    streamed.reserve(padded.size() * static_cast<size_t>(m_factor));
+    process(padded.data(), padded.size(), streamed);
+    const size_t skip = static_cast<size_t>(StreamDelay * m_factor - 1);
+    output.insert(output.end(), streamed.begin() + skip, streamed.begin() + skip + count * m_factor);
+    reset();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Band-limited integer-factor upsampler. Each factor uses a precomputed
+// Blackman-windowed sinc split into polyphase banks of TapsPerPhase taps.
+class PolyphaseUpsampler {
+public:
+    static constexpr int TapsPerPhase = 16;
+    static constexpr int MaxFactor = 8;
+    // Streaming output for input n, phase p sits at input time
+    // n - StreamDelay + (p + 1) / factor.
+    static constexpr int StreamDelay = TapsPerPhase / 2;
+
+    PolyphaseUpsampler() = default;
+    explicit PolyphaseUpsampler(int factor) { setFactor(factor); }
+
+    // Changing the factor clears the filter history.
+    void setFactor(int factor);
+    void reset();
+    [[nodiscard]] int factor() const noexcept { return m_factor; }
+
+    // Appends factor() outputs per input sample, continuing from the
+    // previous call.
+    void process(const float* input, size_t count, std::vector<float>& output);
+    // Upsamples an isolated block with edge samples held, aligned so that
+    // output[m] lies at input time m / factor(). Resets the history.
+    void processBlock(const float* input, size_t count, std::vector<float>& output);
+
+private:
+    int m_factor = 1;
+    const float* m_bank = nullptr;
+    std::vector<float> m_history;
+    std::vector<float> m_window;
+};
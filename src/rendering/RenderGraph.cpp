@@ -0,0 +1,131 @@
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+#include <utility>
+
+void RenderGraph::reset() {
+    m_resources.clear();
+    m_passes.clear();
+    m_slots.clear();
+}
+
+RenderGraph::ResourceId RenderGraph::importResource(std::string name) {
+    Resource resource;
+    resource.name = std::move(name);
+    m_resources.push_back(std::move(resource));
+    return static_cast<ResourceId>(m_resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::createTransient(
+    std::string name, int width, int height, int format
+) {
+    Resource resource;
+    resource.name = std::move(name);
+    resource.transient = true;
+    resource.width = width;
+    resource.height = height;
+    resource.format = format;
+    m_resources.push_back(std::move(resource));
+    return static_cast<ResourceId>(m_resources.size() - 1);
+}
+
+void RenderGraph::addPass(
+    std::string name,
+    std::vector<ResourceId> reads,
+    std::vector<ResourceId> writes,
+    Execute execute
+) {
+    Pass pass;
+    pass.name = std::move(name);
+    pass.reads = std::move(reads);
+    pass.writes = std::move(writes);
+    pass.execute = std::move(execute);
+    m_passes.push_back(std::move(pass));
+}
+
+void RenderGraph::markOutput(ResourceId resource) {
+    if (resource >= 0 && static_cast<size_t>(resource) < m_resources.size()) {
+        m_resources[static_cast<size_t>(resource)].output = true;
+    }
+}
+
+void RenderGraph::compile() {
+    std::vector<bool> needed(m_resources.size(), false);
+    for (size_t i = 0; i < m_resources.size(); ++i) {
+        Resource& resource = m_resources[i];
+        needed[i] = resource.output;
+        resource.firstUse = -1;
+        resource.lastUse = -1;
+        resource.slot = -1;
+    }
+
+    // Writers are kept alive rather than consumed, so earlier passes that
+    // draw into the same resource survive alongside the later ones.
+    for (auto pass = m_passes.rbegin(); pass != m_passes.rend(); ++pass) {
+        pass->active = std::any_of(pass->writes.begin(), pass->writes.end(), [&](ResourceId id) {
+            return id >= 0 && needed[static_cast<size_t>(id)];
+        });
+        if (!pass->active) continue;
+        for (ResourceId id : pass->reads) {
+            if (id >= 0) needed[static_cast<size_t>(id)] = true;
+        }
+    }
+
+    for (size_t index = 0; index < m_passes.size(); ++index) {
+        const Pass& pass = m_passes[index];
+        if (!pass.active) continue;
+        auto touch = [&](ResourceId id) {
+            if (id < 0) return;
+            Resource& resource = m_resources[static_cast<size_t>(id)];
+            if (resource.firstUse < 0) resource.firstUse = static_cast<int>(index);
+            resource.lastUse = static_cast<int>(index);
+        };
+        for (ResourceId id : pass.reads) touch(id);
+        for (ResourceId id : pass.writes) touch(id);
+    }
+
+    std::vector<size_t> transients;
+    for (size_t i = 0; i < m_resources.size(); ++i) {
+        if (m_resources[i].transient && m_resources[i].firstUse >= 0) transients.push_back(i);
+    }
+    std::sort(transients.begin(), transients.end(), [&](size_t a, size_t b) {
+        return m_resources[a].firstUse < m_resources[b].firstUse;
+    });
+
+    m_slots.clear();
+    for (size_t id : transients) {
+        Resource& resource = m_resources[id];
+        auto reusable = std::find_if(m_slots.begin(), m_slots.end(), [&](const Slot& slot) {
+            return slot.width == resource.width && slot.height == resource.height &&
+                   slot.format == resource.format && slot.freeAfter < resource.firstUse;
+        });
+        if (reusable == m_slots.end()) {
+            m_slots.push_back({resource.width, resource.height, resource.format, -1});
+            reusable = m_slots.end() - 1;
+        }
+        reusable->freeAfter = resource.lastUse;
+        resource.slot = static_cast<int>(reusable - m_slots.begin());
+    }
+}
+
+void RenderGraph::execute() const {
+    for (const Pass& pass : m_passes) {
+        if (pass.active && pass.execute) pass.execute();
+    }
+}
+
+bool RenderGraph::passActive(const std::string& name) const {
+    return std::any_of(m_passes.begin(), m_passes.end(), [&](const Pass& pass) {
+        return pass.active && pass.name == name;
+    });
+}
+
+bool RenderGraph::used(ResourceId resource) const {
+    return resource >= 0 && static_cast<size_t>(resource) < m_resources.size() &&
+           m_resources[static_cast<size_t>(resource)].firstUse >= 0;
+}
+
+int RenderGraph::slot(ResourceId resource) const {
+    if (resource < 0 || static_cast<size_t>(resource) >= m_resources.size()) return -1;
+    return m_resources[static_cast<size_t>(resource)].slot;
+}
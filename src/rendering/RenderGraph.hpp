@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Per-frame pass list with declared reads and writes. compile() walks the
+// passes backwards from the marked outputs, so a pass runs only when
+// something downstream consumes what it writes. Transient resources that
+// are never alive at the same time share a physical slot; imported
+// resources (the target, history buffers) keep their own storage.
+// The graph holds no GL state, so the caller maps slots to framebuffers.
+class RenderGraph {
+public:
+    using ResourceId = int;
+    using Execute = std::function<void()>;
+    static constexpr ResourceId NoResource = -1;
+
+    void reset();
+
+    ResourceId importResource(std::string name);
+    // The format is an opaque tag for the caller; only transients with the
+    // same size and format can share a slot.
+    ResourceId createTransient(std::string name, int width, int height, int format = 0);
+
+    // Passes run in the order they are added. A pass that both reads and
+    // writes a resource (e.g. accumulating into the target) keeps every
+    // earlier writer of that resource alive.
+    void addPass(
+        std::string name,
+        std::vector<ResourceId> reads,
+        std::vector<ResourceId> writes,
+        Execute execute);
+    void markOutput(ResourceId resource);
+
+    void compile();
+    void execute() const;
+
+    [[nodiscard]] bool passActive(const std::string& name) const;
+    // Whether a live pass writes or reads the resource this frame.
+    [[nodiscard]] bool used(ResourceId resource) const;
+    // Physical slot of a live transient, or -1 for imported/culled ones.
+    [[nodiscard]] int slot(ResourceId resource) const;
+    [[nodiscard]] size_t slotCount() const noexcept { return m_slots.size(); }
+    [[nodiscard]] int slotWidth(int slot) const { return m_slots[static_cast<size_t>(slot)].width; }
+    [[nodiscard]] int slotHeight(int slot) const { return m_slots[static_cast<size_t>(slot)].height; }
+    [[nodiscard]] int slotFormat(int slot) const { return m_slots[static_cast<size_t>(slot)].format; }
+
+private:
+    struct Resource {
+        std::string name;
+        bool transient = false;
+        bool output = false;
+        int width = 0;
+        int height = 0;
+        int format = 0;
+        int firstUse = -1;
+        int lastUse = -1;
+        int slot = -1;
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        Execute execute;
+        bool active = false;
+    };
+
+    struct Slot {
+        int width = 0;
+        int height = 0;
+        int format = 0;
+        int freeAfter = -1;
+    };
+
+    std::vector<Resource> m_resources;
+    std::vector<Pass> m_passes;
+    std::vector<Slot> m_slots;
+};
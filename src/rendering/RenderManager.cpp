@@ -1,5 +1,6 @@
 #include "RenderManager.hpp"
 #include "AssetPaths.hpp"
+#include "CpuProfiler.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -10,10 +11,22 @@ static float frameIndependentDecay(float decayAt60Fps, float deltaTime) {
     return 1.0f - std::pow(1.0f - decay, std::max(deltaTime, 0.0f) * 60.0f);
 }
 
-static float phosphorDecay(const OscilloscopeDisplaySettings& settings, float deltaTime) {
-    const float seconds = std::max(deltaTime, 0.0f);
-    const float fast = std::exp(-seconds * 1000.0f / std::max(settings.phosphorFastDecayMs, 1.0f));
-    return 1.0f - std::clamp(fast, 0.0f, 1.0f);
+// Energy fraction kept by a phosphor layer over deltaTime.
+static float phosphorRetention(float decayMs, float deltaTime) {
+    return std::exp(-std::max(deltaTime, 0.0f) * 1000.0f / std::max(decayMs, 1.0f));
+}
+
+// Share of the energy leaving the fast phosphor that the slow layer
+// captures. At 60 fps with the default 65 ms decay this equals the old
+// fixed 8% per frame, but it no longer depends on the frame rate.
+static constexpr float SlowPhosphorCapture = 0.35f;
+
+// Persistent XY layers drawn through a CPU hit map instead of the GPU
+// persistence target.
+static bool usesHitMap(const VisualizerLayer& layer) {
+    return layer.visible && layer.useLayerPersistence && layer.xy.cpuPhosphor &&
+           (layer.shape == VisualizerShape::OscilloscopeXY ||
+            layer.shape == VisualizerShape::OscilloscopeXY_Clean);
 }
 
 void RenderManager::renderFrame(
@@ -40,6 +53,7 @@ void RenderManager::renderToTarget(
     float deltaTime,
     bool isOffline
 ) {
+    PLASMOID_PROFILE_FUNCTION();
     bool isBeat = false;
     std::vector<float> audioBuffer;
     
@@ -135,130 +149,10 @@ void RenderManager::renderToTarget(
             }
         }
 
-        // Preserve the caller's target while the persistence and bloom passes
-        // temporarily bind their own framebuffers.
-        GLint targetFramebuffer = 0;
-        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &targetFramebuffer);
-
-        // 1. PERSISTENCE PASS (Render to FBO)
-        visualizer.setupPersistence(width, height);
-        visualizer.beginPersistence();
-
-        bool usePersistence = false;
-        bool useBloom = false;
-        for (auto& l : state.layers) {
-            const bool isXY = l.shape == VisualizerShape::OscilloscopeXY ||
-                              l.shape == VisualizerShape::OscilloscopeXY_Clean;
-            if (l.visible && isXY) {
-                usePersistence |= l.useLayerPersistence;
-                useBloom |= l.bloom > 0.01f;
-            }
-        }
-
-        if (usePersistence) {
-            visualizer.drawFullscreenDimmer(phosphorDecay(state.oscilloscopeDisplay, deltaTime));
-        } else {
-            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
-        }
-
-        // 0. BACKGROUND PASS
-        if (state.zenKunModeEnabled) {
-            visualizer.drawBackground(state.currentBgScale + state.currentShakeZoom, state.currentShakeX, state.currentShakeY, state.currentShakeTilt);
-        }
-        renderMediaBackground(
-            state, visualizer, m_overlayBackground,
-            overlayBackgroundTexture, width, height);
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        renderPersistentLayers(state, audioEngine, visualizer);
-
-        if (state.particlesEnabled) {
-            particleSystem.render();
-        }
-        
-        visualizer.endPersistence();
-
-        // The regular persistence target is the focused, fast phosphor.  Feed
-        // a separately decaying history at low energy for the CRT afterglow.
-        m_slowPhosphorBuffer.resize(width, height);
-        m_slowPhosphorBuffer.bind();
-        glViewport(0, 0, width, height);
-        visualizer.drawFullscreenDimmer(1.0f - std::exp(-std::max(deltaTime, 0.0f) * 1000.0f /
-            std::max(state.oscilloscopeDisplay.phosphorSlowDecayMs, 1.0f)));
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        visualizer.drawTexture(visualizer.persistenceTexture(), 0.08f);
-        Framebuffer::unbind();
-
-        // 2. SCENE PASS: combine persistent and direct layers in HDR before
-        // displaying them. This lets bloom work even when persistence is off.
-        m_sceneBuffer.resize(width, height);
-        m_sceneBuffer.bind();
-        glViewport(0, 0, width, height);
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        if (state.oscilloscopeDisplay.graticuleEnabled) {
-            visualizer.setGridEnabled(true);
-            visualizer.setGridDivisions(state.oscilloscopeDisplay.graticuleColumns, state.oscilloscopeDisplay.graticuleRows);
-            visualizer.setColor(0.3f, 0.75f, 0.55f, state.oscilloscopeDisplay.graticuleOpacity);
-            visualizer.renderGrid();
-        }
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_ONE, GL_ONE);
-        visualizer.drawPersistenceBuffer();
-        visualizer.drawTexture(m_slowPhosphorBuffer.texture(), state.oscilloscopeDisplay.phosphorSlowWeight);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        renderDirectLayers(state, audioEngine, analysisEngine, visualizer);
-
-        // 3. OUTPUT PASS: draw the sharp HDR scene, then add blurred bright
-        // pixels over it. UI is drawn afterward and stays crisp.
-        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(targetFramebuffer));
-        glViewport(0, 0, width, height);
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        glBlendFunc(GL_ONE, GL_ONE);
-        visualizer.drawTexture(m_sceneBuffer.texture());
-
-        if (useBloom) {
-            m_bloomRenderer.render(
-                m_sceneBuffer.texture(),
-                static_cast<GLuint>(targetFramebuffer),
-                width,
-                height);
-        }
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        // 4. Transparent metadata/spectrum/lyrics preset. This native OpenGL
-        // pass is shared with offline rendering; ImGui remains editor-only.
-        if (state.mediaOverlay.enabled) {
-            LayerConfig overlaySpectrum;
-            overlaySpectrum.numBars = 192;
-            overlaySpectrum.gain = 0.012f;
-            overlaySpectrum.attack = 0.82f;
-            overlaySpectrum.falloff = 0.88f;
-            overlaySpectrum.smoothing = 1;
-            const auto spectrum = m_overlayAnalysis.computeLayerMagnitudes(
-                overlaySpectrum, m_overlayPrevMagnitudes);
-            OverlayFrameData frame;
-            frame.fft = &spectrum;
-            frame.lyrics = &state.mediaOverlay.lyrics;
-            frame.timestampSeconds = audioEngine.getPosition();
-            frame.artist = state.mediaOverlay.artist;
-            frame.title = state.mediaOverlay.title;
-            frame.previewLyric = state.mediaOverlay.lyricPreview;
-            if (state.mediaOverlay.style.blurredLyricsBand) {
-                frame.blurredSceneTexture = m_overlayBlurRenderer.blur(
-                    m_sceneBuffer.texture(), width, height);
-                glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(targetFramebuffer));
-                glViewport(0, 0, width, height);
-            }
-            m_overlayRenderer.render(visualizer, state.mediaOverlay.style, frame);
-        }
+        const FrameSources sources{
+            audioEngine, m_overlayBackground, overlayBackgroundTexture,
+            m_overlayPrevMagnitudes, overlayTime};
+        renderPipeline(state, analysisEngine, visualizer, particleSystem, sources, width, height, deltaTime);
 
     } catch (const std::exception& e) {
         std::cerr << "EXCEPTION in RenderManager: " << e.what() << std::endl;
@@ -280,6 +174,7 @@ void RenderManager::renderOfflineFrame(
     std::uint64_t audioStartFrame,
     std::uint32_t sampleRate
 ) {
+    PLASMOID_PROFILE_FUNCTION();
     bool isBeat = false;
 
     try {
@@ -373,42 +268,8 @@ void RenderManager::renderOfflineFrame(
             }
         }
 
-        GLint targetFramebuffer = 0;
-        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &targetFramebuffer);
-
-        // 1. PERSISTENCE PASS (Render to FBO)
-        visualizer.setupPersistence(width, height);
-        visualizer.beginPersistence();
-
-        bool usePersistence = false;
-        bool useBloom = false;
-        for (auto& l : state.layers) {
-            const bool isXY = l.shape == VisualizerShape::OscilloscopeXY ||
-                              l.shape == VisualizerShape::OscilloscopeXY_Clean;
-            if (l.visible && isXY) {
-                usePersistence |= l.useLayerPersistence;
-                useBloom |= l.bloom > 0.01f;
-            }
-        }
-
-        if (usePersistence) {
-            visualizer.drawFullscreenDimmer(phosphorDecay(state.oscilloscopeDisplay, deltaTime));
-        } else {
-            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
-        }
-
-        // 0. BACKGROUND PASS
-        if (state.zenKunModeEnabled) {
-            visualizer.drawBackground(state.currentBgScale + state.currentShakeZoom, state.currentShakeX, state.currentShakeY, state.currentShakeTilt);
-        }
-        renderMediaBackground(
-            state, visualizer, m_offlineOverlayBackground,
-            overlayBackgroundTexture, width, height);
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
+        // Global gain is applied once here; every layer views these chunks.
+        const float gain = state.globalGain;
         XYInputChunk offlineContinuous;
         offlineContinuous.firstFrame = audioStartFrame;
         offlineContinuous.sampleRate = sampleRate;
@@ -418,7 +279,7 @@ void RenderManager::renderOfflineFrame(
             static_cast<size_t>(std::ceil(deltaTime * sampleRate)));
         offlineContinuous.samples.reserve(continuousFrames);
         for (size_t i = 0; i < continuousFrames; ++i) {
-            offlineContinuous.samples.push_back({stereoBuffer[i * 2], stereoBuffer[i * 2 + 1], 1.0f});
+            offlineContinuous.samples.push_back({stereoBuffer[i * 2] * gain, stereoBuffer[i * 2 + 1] * gain, 1.0f});
         }
 
         XYInputChunk offlineSnapshot;
@@ -427,69 +288,202 @@ void RenderManager::renderOfflineFrame(
         offlineSnapshot.discontinuityGeneration = 1;
         offlineSnapshot.samples.reserve(stereoBuffer.size() / 2);
         for (size_t i = 0; i < stereoBuffer.size() / 2; ++i) {
-            offlineSnapshot.samples.push_back({stereoBuffer[i * 2], stereoBuffer[i * 2 + 1], 1.0f});
+            offlineSnapshot.samples.push_back({stereoBuffer[i * 2] * gain, stereoBuffer[i * 2 + 1] * gain, 1.0f});
         }
 
-        // For persistent layers, consume exactly this video frame's samples.
         AudioEngine dummyAudio; // Not used in offline path
-        renderPersistentLayers(state, dummyAudio, visualizer, &offlineContinuous);
+        FrameSources sources{
+            dummyAudio, m_offlineOverlayBackground, overlayBackgroundTexture,
+            m_offlineOverlayPrevMagnitudes, overlayTime};
+        // Persistent layers consume exactly this video frame's samples.
+        sources.continuousXY = &offlineContinuous;
+        sources.snapshotXY = &offlineSnapshot;
+        sources.mono = &monoBuffer;
+        renderPipeline(state, analysisEngine, visualizer, particleSystem, sources, width, height, deltaTime);
 
-        if (state.particlesEnabled) {
-            particleSystem.render();
+        if (state.videoStatus.currentFrame + 1 >= state.videoStatus.totalFrames) {
+            m_offlineOverlayBackground.reset();
         }
-        
-        visualizer.endPersistence();
 
-        m_slowPhosphorBuffer.resize(width, height);
-        m_slowPhosphorBuffer.bind();
+    } catch (const std::exception& e) {
+        std::cerr << "EXCEPTION in RenderManager (Offline): " << e.what() << std::endl;
+    }
+}
+
+void RenderManager::renderPipeline(
+    AppState& state,
+    AnalysisEngine& analysisEngine,
+    Visualizer& visualizer,
+    ParticleSystem& particleSystem,
+    const FrameSources& sources,
+    int width,
+    int height,
+    float deltaTime
+) {
+    using ResourceId = RenderGraph::ResourceId;
+
+    // Preserve the caller's target while the persistence and bloom passes
+    // temporarily bind their own framebuffers.
+    GLint boundFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &boundFramebuffer);
+    const GLuint targetFramebuffer = static_cast<GLuint>(boundFramebuffer);
+
+    visualizer.setupPersistence(width, height);
+    visualizer.setGpuRibbonExpansion(state.oscilloscopeDisplay.gpuRibbonExpansion);
+    visualizer.beginFrame();
+
+    bool usePersistence = false;
+    bool useBloom = false;
+    for (auto& l : state.layers) {
+        const bool isXY = l.shape == VisualizerShape::OscilloscopeXY ||
+                          l.shape == VisualizerShape::OscilloscopeXY_Clean;
+        if (l.visible && isXY) {
+            usePersistence |= l.useLayerPersistence;
+            useBloom |= l.bloom > 0.01f;
+        }
+    }
+    const auto& display = state.oscilloscopeDisplay;
+    const bool blurLyrics = state.mediaOverlay.enabled && state.mediaOverlay.style.blurredLyricsBand;
+
+    m_targetPool.beginFrame();
+    m_graph.reset();
+    const ResourceId target = m_graph.importResource("target");
+    const ResourceId persistence = m_graph.importResource("persistence");
+    // Only bloom and the lyrics band sample the HDR scene. Without them it
+    // is composed straight into the target and the copy pass disappears.
+    // The scene is what gets displayed, so it stays Rgba16F; R11G11B10F's
+    // 5-bit blue mantissa bands smooth backgrounds. Only the pyramid and
+    // bloom levels, which are blurred anyway, use the packed format.
+    const ResourceId scene = useBloom || blurLyrics
+        ? m_graph.createTransient(
+              "scene", width, height, static_cast<int>(Framebuffer::Format::Rgba16F))
+        : target;
+    // Levels live in the pool; the graph only tracks who consumes them.
+    const ResourceId pyramid = m_graph.importResource("blur-pyramid");
+
+    auto bindResource = [&](ResourceId resource) {
+        if (resource == target) {
+            glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+        } else {
+            transientTarget(resource).bind();
+        }
         glViewport(0, 0, width, height);
-        visualizer.drawFullscreenDimmer(1.0f - std::exp(-std::max(deltaTime, 0.0f) * 1000.0f /
-            std::max(state.oscilloscopeDisplay.phosphorSlowDecayMs, 1.0f)));
+    };
+
+    // 1. PERSISTENCE PASS (Render to FBO). The fast phosphor is the focused
+    // trace; a slow layer fed from it gives the CRT afterglow. Both decay in
+    // one MRT pass, and the slow one is zeroed while nothing shows it.
+    const bool useSlowPhosphor = usePersistence && display.phosphorSlowWeight > 0.0f;
+    m_graph.addPass("persistence", {}, {persistence}, [&] {
+        PLASMOID_PROFILE_ZONE("persistence");
+        GpuProfiler::Scope timer(m_gpuProfiler, "persistence");
+        if (usePersistence) {
+            const float fastRetain = phosphorRetention(display.phosphorFastDecayMs, deltaTime);
+            visualizer.decayPersistence(
+                fastRetain,
+                useSlowPhosphor ? phosphorRetention(display.phosphorSlowDecayMs, deltaTime) : 0.0f,
+                useSlowPhosphor ? SlowPhosphorCapture * (1.0f - fastRetain) : 0.0f);
+        } else {
+            visualizer.decayPersistence(0.0f, 0.0f, 0.0f);
+        }
+        visualizer.beginPersistence();
+
+        // 0. BACKGROUND PASS
+        if (state.zenKunModeEnabled) {
+            visualizer.drawBackground(state.currentBgScale + state.currentShakeZoom, state.currentShakeX, state.currentShakeY, state.currentShakeTilt);
+        }
+        renderMediaBackground(
+            state, visualizer, sources.background,
+            sources.backgroundTexture, width, height);
+
         glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        visualizer.drawTexture(visualizer.persistenceTexture(), 0.08f);
-        Framebuffer::unbind();
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        // 2. HDR scene pass.
-        m_sceneBuffer.resize(width, height);
-        m_sceneBuffer.bind();
-        glViewport(0, 0, width, height);
+        if (!sources.continuousXY) acquireXYInput(state, sources.audio);
+        renderPersistentLayers(state, visualizer, deltaTime, sources.continuousXY);
+
+        if (state.particlesEnabled) {
+            particleSystem.render(visualizer.vertexStream());
+        }
+        visualizer.endPersistence();
+    });
+
+    // 2. SCENE PASS: combine persistent and direct layers in HDR before
+    // displaying them. This lets bloom work even when persistence is off.
+    m_graph.addPass("scene", {persistence}, {scene}, [&] {
+        PLASMOID_PROFILE_ZONE("scene");
+        GpuProfiler::Scope timer(m_gpuProfiler, "scene");
+        bindResource(scene);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        if (state.oscilloscopeDisplay.graticuleEnabled) {
+        if (display.graticuleEnabled) {
             visualizer.setGridEnabled(true);
-            visualizer.setGridDivisions(state.oscilloscopeDisplay.graticuleColumns, state.oscilloscopeDisplay.graticuleRows);
-            visualizer.setColor(0.3f, 0.75f, 0.55f, state.oscilloscopeDisplay.graticuleOpacity);
+            visualizer.setGridDivisions(display.graticuleColumns, display.graticuleRows);
+            visualizer.setGridDecorations(display.graticuleTicks, display.graticuleCrosshair);
+            visualizer.setColor(0.3f, 0.75f, 0.55f, display.graticuleOpacity);
             visualizer.renderGrid();
         }
 
         glEnable(GL_BLEND);
         glBlendFunc(GL_ONE, GL_ONE);
-        visualizer.drawPersistenceBuffer();
-        visualizer.drawTexture(m_slowPhosphorBuffer.texture(), state.oscilloscopeDisplay.phosphorSlowWeight);
+        visualizer.drawPersistenceBuffer(useSlowPhosphor ? display.phosphorSlowWeight : 0.0f);
+        drawHitMaps(state, visualizer);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        renderDirectLayers(state, dummyAudio, analysisEngine, visualizer, &offlineSnapshot, &monoBuffer);
-
-        // 3. Output to the offline capture framebuffer.
-        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(targetFramebuffer));
-        glViewport(0, 0, width, height);
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        glBlendFunc(GL_ONE, GL_ONE);
-        visualizer.drawTexture(m_sceneBuffer.texture());
-
+        renderDirectLayers(
+            state, sources.audio, analysisEngine, visualizer,
+            sources.snapshotXY, sources.mono);
+    });
+
+    // 3. OUTPUT PASS: draw the sharp HDR scene, then add blurred bright
+    // pixels over it. UI is drawn afterward and stays crisp.
+    if (scene != target) {
+        m_graph.addPass("compose", {scene}, {target}, [&] {
+            PLASMOID_PROFILE_ZONE("compose");
+            GpuProfiler::Scope timer(m_gpuProfiler, "compose");
+            bindResource(target);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            visualizer.drawTexture(transientTarget(scene).texture());
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        });
+    }
+    // One downsample chain of the scene feeds both bloom and the lyrics band.
+    // Without bloom only the bottom lyrics band is ever sampled, so the chain
+    // stops at its level and the passes are scissored to the band.
+    GLuint lyricsBlurTexture = 0;
+    m_graph.addPass("blur-pyramid", {scene}, {pyramid}, [&] {
+        PLASMOID_PROFILE_ZONE("blur-pyramid");
+        GpuProfiler::Scope timer(m_gpuProfiler, "blur-pyramid");
         if (useBloom) {
-            m_bloomRenderer.render(
-                m_sceneBuffer.texture(),
-                static_cast<GLuint>(targetFramebuffer),
-                width,
-                height);
-        }
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            m_blurPyramid.build(m_targetPool, transientTarget(scene).texture(), width, height);
+        } else {
+            BlurPyramid::Region band;
+            band.top = std::clamp(state.mediaOverlay.style.lyricsBandHeight, 0.0f, 1.0f);
+            m_blurPyramid.build(
+                m_targetPool, transientTarget(scene).texture(), width, height,
+                LyricsBlurLevel + 1, band);
+        }
+        if (blurLyrics) lyricsBlurTexture = m_blurPyramid.upsampledBlur(m_targetPool, LyricsBlurLevel);
+    });
+    if (useBloom) {
+        m_graph.addPass("bloom", {pyramid, target}, {target}, [&] {
+            PLASMOID_PROFILE_ZONE("bloom");
+            GpuProfiler::Scope timer(m_gpuProfiler, "bloom");
+            m_bloomRenderer.render(m_blurPyramid, targetFramebuffer, width, height);
+        });
+    }
 
-        // 4. Matching offline overlay for deterministic video exports.
-        if (state.mediaOverlay.enabled) {
+    // 4. Transparent metadata/spectrum/lyrics preset. This native OpenGL
+    // pass is shared with offline rendering; ImGui remains editor-only.
+    if (state.mediaOverlay.enabled) {
+        std::vector<ResourceId> overlayInputs{target};
+        if (blurLyrics) overlayInputs.push_back(pyramid);
+        m_graph.addPass("overlay", overlayInputs, {target}, [&] {
+            PLASMOID_PROFILE_ZONE("overlay");
+            GpuProfiler::Scope timer(m_gpuProfiler, "overlay");
             LayerConfig overlaySpectrum;
             overlaySpectrum.numBars = 192;
             overlaySpectrum.gain = 0.012f;
@@ -497,31 +491,38 @@ void RenderManager::renderOfflineFrame(
             overlaySpectrum.falloff = 0.88f;
             overlaySpectrum.smoothing = 1;
             const auto spectrum = m_overlayAnalysis.computeLayerMagnitudes(
-                overlaySpectrum, m_offlineOverlayPrevMagnitudes);
+                overlaySpectrum, sources.overlayPrevMagnitudes);
             OverlayFrameData frame;
             frame.fft = &spectrum;
             frame.lyrics = &state.mediaOverlay.lyrics;
-            frame.timestampSeconds =
-                static_cast<float>(state.videoStatus.currentFrame) /
-                static_cast<float>(std::max(state.videoSettings.fps, 1));
+            frame.timestampSeconds = sources.timestampSeconds;
             frame.artist = state.mediaOverlay.artist;
             frame.title = state.mediaOverlay.title;
             frame.previewLyric = state.mediaOverlay.lyricPreview;
-            if (state.mediaOverlay.style.blurredLyricsBand) {
-                frame.blurredSceneTexture = m_overlayBlurRenderer.blur(
-                    m_sceneBuffer.texture(), width, height);
-                glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(targetFramebuffer));
-                glViewport(0, 0, width, height);
-            }
+            frame.blurredSceneTexture = lyricsBlurTexture;
+            bindResource(target);
             m_overlayRenderer.render(visualizer, state.mediaOverlay.style, frame);
-        }
-        if (state.videoStatus.currentFrame + 1 >= state.videoStatus.totalFrames) {
-            m_offlineOverlayBackground.reset();
-        }
+        });
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "EXCEPTION in RenderManager (Offline): " << e.what() << std::endl;
+    m_graph.markOutput(target);
+    m_graph.compile();
+
+    m_transientTargets.clear();
+    for (size_t slot = 0; slot < m_graph.slotCount(); ++slot) {
+        m_transientTargets.push_back(&m_targetPool.acquire(
+            m_graph.slotWidth(static_cast<int>(slot)),
+            m_graph.slotHeight(static_cast<int>(slot)),
+            static_cast<Framebuffer::Format>(m_graph.slotFormat(static_cast<int>(slot)))));
     }
+
+    m_graph.execute();
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    glViewport(0, 0, width, height);
+}
+
+Framebuffer& RenderManager::transientTarget(RenderGraph::ResourceId resource) {
+    return *m_transientTargets.at(static_cast<size_t>(m_graph.slot(resource)));
 }
 
 void RenderManager::renderMediaBackground(
@@ -585,42 +586,105 @@ void RenderManager::renderMediaBackground(
 
 void RenderManager::renderPersistentLayers(
     AppState& state,
-    AudioEngine& audioEngine,
     Visualizer& visualizer,
+    float deltaTime,
     const XYInputChunk* offlineXY
 ) {
+    PLASMOID_PROFILE_FUNCTION();
+    std::vector<XYOscilloscopeEngine::LayerJob> jobs;
+    std::vector<VisualizerLayer*> jobLayers;
     for (auto& layer : state.layers) {
         if (!layer.visible || !layer.useLayerPersistence) continue;
         if (layer.shape != VisualizerShape::OscilloscopeXY && layer.shape != VisualizerShape::OscilloscopeXY_Clean) continue;
 
         if (layer.id == 0) layer.id = state.allocateLayerId();
-        XYInputChunk input;
+        XYInputView input;
         if (offlineXY) {
-            input = *offlineXY;
+            input = XYInputView(*offlineXY);
         } else {
+            const std::uint64_t end = m_xyFrameInput.firstFrame + m_xyFrameInput.samples.size();
             auto cursor = m_xyCursors.find(layer.id);
             if (cursor == m_xyCursors.end()) {
-                m_xyCursors[layer.id] = audioEngine.latestXYFrame();
+                m_xyCursors[layer.id] = end;
                 continue;
             }
-            input = audioEngine.readXYSince(cursor->second, 32768);
-            cursor->second = input.firstFrame + input.samples.size();
-        }
-        if (state.globalGain != 1.0f) {
-            for (auto& sample : input.samples) { sample.x *= state.globalGain; sample.y *= state.globalGain; }
+            // Frames before the shared slice were lost to this layer.
+            const bool missed = cursor->second < m_xyFrameInput.firstFrame;
+            input = XYInputView(m_xyFrameInput, missed ? 0 : static_cast<size_t>(cursor->second - m_xyFrameInput.firstFrame));
+            input.dropped |= missed;
+            cursor->second = end;
         }
-        if (input.samples.empty()) continue;
+        if (input.empty()) continue;
 
         layer.xy.persistence = true;
-        auto trace = m_xyEngine.processContinuous(
-            layer.id, layer.xy, input, visualizer.viewportWidth(), visualizer.viewportHeight());
-        layer.xyMeasurements = trace.measurements;
+        jobs.push_back({layer.id, layer.xy, input, true, {}});
+        jobLayers.push_back(&layer);
+    }
+
+    // Hit maps of layers that were removed, hidden or moved back to the GPU
+    // path are dropped; the rest decay every frame, with or without input.
+    for (auto hitMap = m_hitMaps.begin(); hitMap != m_hitMaps.end();) {
+        const bool live = std::any_of(state.layers.begin(), state.layers.end(), [&](const VisualizerLayer& layer) {
+            return layer.id == hitMap->first && usesHitMap(layer);
+        });
+        hitMap = live ? std::next(hitMap) : m_hitMaps.erase(hitMap);
+    }
+    const float hitMapDecay = std::exp(-std::max(deltaTime, 0.0f) * 1000.0f /
+        std::max(state.oscilloscopeDisplay.phosphorFastDecayMs, 1.0f));
+    for (auto& [id, hitMap] : m_hitMaps) {
+        const bool fed = std::any_of(jobs.begin(), jobs.end(), [id = id](const auto& job) {
+            return job.layerId == id;
+        });
+        if (!fed) hitMap.accumulate(XYTraceBatch{}, {}, hitMapDecay, &m_hitMapWorkers);
+    }
 
+    // Conditioning and trace building run across cores; draws stay in layer order.
+    m_xyEngine.processLayers(jobs, visualizer.viewportWidth(), visualizer.viewportHeight());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        VisualizerLayer& layer = *jobLayers[i];
+        GpuProfiler::Scope timer(m_gpuProfiler, layer.id, layer.name);
+        layer.xyMeasurements = jobs[i].trace.measurements;
+        layer.xyTraceStats = jobs[i].trace.stats;
+        if (layer.xy.cpuPhosphor) {
+            // Hit-map layers keep their own decaying buffer instead of
+            // drawing into the shared persistence target.
+            PhosphorAccumulator& hitMap = m_hitMaps[layer.id];
+            hitMap.resize(visualizer.viewportWidth(), visualizer.viewportHeight());
+            hitMap.accumulate(jobs[i].trace, {layer.xy.traceWidth, layer.xy.densityEffect}, hitMapDecay, &m_hitMapWorkers);
+            continue;
+        }
         visualizer.setColor(layer.color[0], layer.color[1], layer.color[2], layer.color[3]);
         visualizer.setShape(layer.shape);
         visualizer.setBloomIntensity(layer.xy.bloom);
         visualizer.setTraceWidth(layer.xy.traceWidth);
-        visualizer.renderXY(trace);
+        visualizer.renderXY(jobs[i].trace);
+    }
+}
+
+void RenderManager::acquireXYInput(const AppState& state, AudioEngine& audioEngine) {
+    PLASMOID_PROFILE_FUNCTION();
+    // One read covers the oldest persistent cursor and the direct-layer
+    // window, so every XY layer this frame takes a view of the same slice.
+    const std::uint64_t latest = audioEngine.latestXYFrame();
+    std::uint64_t start = latest > DirectXYFrames ? latest - DirectXYFrames : 0;
+    for (const auto& layer : state.layers) {
+        if (!layer.visible || !layer.useLayerPersistence) continue;
+        const auto cursor = m_xyCursors.find(layer.id);
+        if (cursor != m_xyCursors.end()) start = std::min(start, cursor->second);
+    }
+    m_xyFrameInput = audioEngine.readXYSince(start, MaxXYFramesPerRead);
+    if (state.globalGain != 1.0f) {
+        for (auto& sample : m_xyFrameInput.samples) { sample.x *= state.globalGain; sample.y *= state.globalGain; }
+    }
+}
+
+void RenderManager::drawHitMaps(const AppState& state, Visualizer& visualizer) {
+    for (const auto& layer : state.layers) {
+        if (!usesHitMap(layer)) continue;
+        const auto hitMap = m_hitMaps.find(layer.id);
+        if (hitMap == m_hitMaps.end()) continue;
+        visualizer.setColor(layer.color[0], layer.color[1], layer.color[2], layer.color[3]);
+        visualizer.drawIntensityMap(hitMap->second.data(), hitMap->second.width(), hitMap->second.height());
     }
 }
 
@@ -632,25 +696,48 @@ void RenderManager::renderDirectLayers(
     const XYInputChunk* offlineXY,
     const std::vector<float>* offlineMono
 ) {
+    PLASMOID_PROFILE_FUNCTION();
+    // Triggered XY layers are processed together up front so their CPU work
+    // runs in parallel; the loop below only draws the finished traces.
+    std::vector<XYOscilloscopeEngine::LayerJob> xyJobs;
+    std::unordered_map<LayerId, size_t> xyJobIndex;
+    for (auto& layer : state.layers) {
+        if (!layer.visible || layer.useLayerPersistence) continue;
+        if (layer.shape != VisualizerShape::OscilloscopeXY && layer.shape != VisualizerShape::OscilloscopeXY_Clean) continue;
+        if (layer.id == 0) layer.id = state.allocateLayerId();
+        const XYInputChunk& shared = offlineXY ? *offlineXY : m_xyFrameInput;
+        const size_t offset = !offlineXY && shared.samples.size() > DirectXYFrames
+            ? shared.samples.size() - DirectXYFrames : 0;
+        XYInputView input(shared, offset);
+        if (!offlineXY) {
+            // The shared read may reach back for a persistent layer's cursor;
+            // only frames lost inside this layer's own window count as dropped.
+            const std::uint64_t end = shared.firstFrame + shared.samples.size();
+            const std::uint64_t windowStart = end > DirectXYFrames ? end - DirectXYFrames : 0;
+            input.dropped = shared.dropped && shared.firstFrame > windowStart;
+        }
+        if (input.empty()) continue;
+        layer.xy.persistence = false;
+        xyJobIndex[layer.id] = xyJobs.size();
+        xyJobs.push_back({layer.id, layer.xy, input, false, {}});
+    }
+    m_xyEngine.processLayers(xyJobs, visualizer.viewportWidth(), visualizer.viewportHeight());
+
     for (auto& layer : state.layers) {
         if (!layer.visible) continue;
         if (layer.id == 0) layer.id = state.allocateLayerId();
         // Skip persistent XY layers (they are handled in renderPersistentLayers)
         if ((layer.shape == VisualizerShape::OscilloscopeXY || layer.shape == VisualizerShape::OscilloscopeXY_Clean) && layer.useLayerPersistence) continue;
 
+        GpuProfiler::Scope timer(m_gpuProfiler, layer.id, layer.name);
         std::vector<float> renderData;
         if (layer.shape == VisualizerShape::OscilloscopeXY ||
             layer.shape == VisualizerShape::OscilloscopeXY_Clean) {
-            if (layer.id == 0) layer.id = state.allocateLayerId();
-            XYInputChunk input = offlineXY ? *offlineXY : audioEngine.snapshotXY(8192);
-            if (state.globalGain != 1.0f) {
-                for (auto& sample : input.samples) { sample.x *= state.globalGain; sample.y *= state.globalGain; }
-            }
-            if (input.samples.empty()) continue;
-            layer.xy.persistence = false;
-            auto trace = m_xyEngine.processTriggered(
-                layer.id, layer.xy, input, visualizer.viewportWidth(), visualizer.viewportHeight());
+            const auto job = xyJobIndex.find(layer.id);
+            if (job == xyJobIndex.end()) continue;
+            const XYTraceBatch& trace = xyJobs[job->second].trace;
             layer.xyMeasurements = trace.measurements;
+            layer.xyTraceStats = trace.stats;
             visualizer.setColor(layer.color[0], layer.color[1], layer.color[2], layer.color[3]);
             visualizer.setShape(layer.shape);
             visualizer.setBloomIntensity(layer.xy.bloom);
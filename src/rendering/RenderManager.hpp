@@ -11,8 +11,12 @@
 #include "BloomRenderer.hpp"
 #include "XYOscilloscopeEngine.hpp"
 #include "OverlayPreset.hpp"
-#include "GaussianBlurRenderer.hpp"
 #include "AnimatedBackground.hpp"
+#include "PhosphorAccumulator.hpp"
+#include "WorkerPool.hpp"
+#include "RenderGraph.hpp"
+#include "FramebufferPool.hpp"
+#include "GpuProfiler.hpp"
 #include <vector>
 #include <unordered_map>
 
@@ -57,11 +61,14 @@ public:
 
     void renderPersistentLayers(
         AppState& state,
-        AudioEngine& audioEngine,
         Visualizer& visualizer,
+        float deltaTime,
         const XYInputChunk* offlineXY = nullptr
     );
 
+    void acquireXYInput(const AppState& state, AudioEngine& audioEngine);
+    void drawHitMaps(const AppState& state, Visualizer& visualizer);
+
     void renderDirectLayers(
         AppState& state,
         AudioEngine& audioEngine,
@@ -71,6 +78,9 @@ public:
         const std::vector<float>* offlineMono = nullptr
     );
 
+    // Optional; when set, every render-graph pass and layer draw is timed.
+    void setGpuProfiler(GpuProfiler* profiler) noexcept { m_gpuProfiler = profiler; }
+
     void renderMediaBackground(
         const AppState& state,
         Visualizer& visualizer,
@@ -80,13 +90,46 @@ public:
         int height);
 
 private:
+    // What differs between the live and offline paths. Null XY/mono inputs
+    // mean the frame reads from the audio engine.
+    struct FrameSources {
+        AudioEngine& audio;
+        AnimatedBackground& background;
+        GLuint backgroundTexture = 0;
+        std::vector<float>& overlayPrevMagnitudes;
+        float timestampSeconds = 0.0f;
+        const XYInputChunk* continuousXY = nullptr;
+        const XYInputChunk* snapshotXY = nullptr;
+        const std::vector<float>* mono = nullptr;
+    };
+
+    void renderPipeline(
+        AppState& state,
+        AnalysisEngine& analysisEngine,
+        Visualizer& visualizer,
+        ParticleSystem& particleSystem,
+        const FrameSources& sources,
+        int width,
+        int height,
+        float deltaTime);
+    Framebuffer& transientTarget(RenderGraph::ResourceId resource);
+
+    static constexpr size_t DirectXYFrames = 8192;
+    static constexpr size_t MaxXYFramesPerRead = 32768;
+    // Pyramid level behind the lyrics band: 1/8 of the frame at 1080p, close
+    // to the softness of the old eight-pass Gaussian. It is tent-upsampled
+    // to the level above before the overlay stretches it.
+    static constexpr int LyricsBlurLevel = 2;
+
+    FramebufferPool m_targetPool;
+    BlurPyramid m_blurPyramid;
     BloomRenderer m_bloomRenderer;
-    Framebuffer m_sceneBuffer;
-    Framebuffer m_slowPhosphorBuffer;
+    RenderGraph m_graph;
+    std::vector<Framebuffer*> m_transientTargets;
+    GpuProfiler* m_gpuProfiler = nullptr;
     XYOscilloscopeEngine m_xyEngine;
     AnalysisEngine m_overlayAnalysis{8192};
     OverlayPresetRenderer m_overlayRenderer;
-    GaussianBlurRenderer m_overlayBlurRenderer;
     AnimatedBackground m_overlayBackground;
     AnimatedBackground m_offlineOverlayBackground;
     std::string m_loadedOverlayFont;
@@ -95,6 +138,9 @@ private:
     std::vector<float> m_offlineOverlayPrevMagnitudes;
     std::unordered_map<LayerId, std::vector<float>> m_offlineLayerPrevMagnitudes;
     std::unordered_map<LayerId, std::uint64_t> m_xyCursors;
+    XYInputChunk m_xyFrameInput;
+    std::unordered_map<LayerId, PhosphorAccumulator> m_hitMaps;
+    WorkerPool m_hitMapWorkers;
     GLuint m_captureFbo = 0;
     GLuint m_captureTex = 0;
     GLuint m_captureRbo = 0;
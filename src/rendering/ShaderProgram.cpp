@@ -1,6 +1,7 @@
 #include "ShaderProgram.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -38,6 +39,16 @@ GLuint compile(GLenum type, const std::string& source, const std::filesystem::pa
 
     return shader;
 }
+
+GLuint currentProgram = 0;
+
+template <typename... Values>
+std::array<std::uint32_t, 4> pack(Values... values) {
+    std::array<std::uint32_t, 4> packed{};
+    const std::array<float, sizeof...(Values)> floats{static_cast<float>(values)...};
+    std::memcpy(packed.data(), floats.data(), sizeof(floats));
+    return packed;
+}
 }
 
 ShaderProgram::~ShaderProgram() {
@@ -45,12 +56,18 @@ ShaderProgram::~ShaderProgram() {
 }
 
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
-    : m_id(std::exchange(other.m_id, 0)) {}
+    : m_id(std::exchange(other.m_id, 0)),
+      m_locations(std::move(other.m_locations)),
+      m_values(std::move(other.m_values)),
+      m_valueKnown(std::move(other.m_valueKnown)) {}
 
 ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
     if (this != &other) {
         reset();
         m_id = std::exchange(other.m_id, 0);
+        m_locations = std::move(other.m_locations);
+        m_values = std::move(other.m_values);
+        m_valueKnown = std::move(other.m_valueKnown);
     }
     return *this;
 }
@@ -86,6 +103,29 @@ void ShaderProgram::load(
         glDeleteShader(fragmentShader);
         reset();
         m_id = program;
+
+        GLint uniformCount = 0;
+        GLint maxNameLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+        GLint maxLocation = -1;
+        for (GLint i = 0; i < uniformCount; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+            std::string uniformName(name.data(), static_cast<size_t>(length));
+            if (const auto bracket = uniformName.find('['); bracket != std::string::npos) {
+                uniformName.resize(bracket);
+            }
+            const GLint location = glGetUniformLocation(program, uniformName.c_str());
+            if (location < 0) continue;
+            m_locations.emplace(std::move(uniformName), location);
+            maxLocation = std::max(maxLocation, location);
+        }
+        m_values.assign(static_cast<size_t>(maxLocation + 1), CachedValue{});
+        m_valueKnown.assign(static_cast<size_t>(maxLocation + 1), false);
     } catch (...) {
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
@@ -96,7 +136,55 @@ void ShaderProgram::load(
 
 void ShaderProgram::reset() noexcept {
     if (m_id != 0) {
+        if (currentProgram == m_id) currentProgram = 0;
         glDeleteProgram(m_id);
         m_id = 0;
     }
+    m_locations.clear();
+    m_values.clear();
+    m_valueKnown.clear();
+}
+
+ShaderProgram::Uniform ShaderProgram::uniform(const std::string& name) const {
+    const auto found = m_locations.find(name);
+    return found != m_locations.end() ? Uniform{found->second} : Uniform{};
+}
+
+void ShaderProgram::use() const {
+    if (currentProgram == m_id) return;
+    glUseProgram(m_id);
+    currentProgram = m_id;
+}
+
+void ShaderProgram::unbind() {
+    if (currentProgram == 0) return;
+    glUseProgram(0);
+    currentProgram = 0;
+}
+
+bool ShaderProgram::changed(Uniform uniform, const CachedValue& value) {
+    if (!uniform || static_cast<size_t>(uniform.location) >= m_values.size()) return false;
+    const auto index = static_cast<size_t>(uniform.location);
+    if (m_valueKnown[index] && m_values[index] == value) return false;
+    m_values[index] = value;
+    m_valueKnown[index] = true;
+    return true;
+}
+
+void ShaderProgram::set(Uniform uniform, GLint value) {
+    CachedValue packed{};
+    std::memcpy(packed.data(), &value, sizeof(value));
+    if (changed(uniform, packed)) glUniform1i(uniform.location, value);
+}
+
+void ShaderProgram::set(Uniform uniform, GLfloat value) {
+    if (changed(uniform, pack(value))) glUniform1f(uniform.location, value);
+}
+
+void ShaderProgram::set(Uniform uniform, GLfloat x, GLfloat y) {
+    if (changed(uniform, pack(x, y))) glUniform2f(uniform.location, x, y);
+}
+
+void ShaderProgram::set(Uniform uniform, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+    if (changed(uniform, pack(x, y, z, w))) glUniform4f(uniform.location, x, y, z, w);
 }
@@ -1,10 +1,22 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <array>
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class ShaderProgram {
 public:
+    // Location of an active uniform, resolved once at link time. Missing or
+    // optimised-out uniforms stay at -1, which the setters ignore.
+    struct Uniform {
+        GLint location = -1;
+        [[nodiscard]] explicit operator bool() const noexcept { return location >= 0; }
+    };
+
     ShaderProgram() = default;
     ~ShaderProgram();
 
@@ -16,9 +28,30 @@ public:
     void load(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath);
     void reset() noexcept;
 
+    [[nodiscard]] Uniform uniform(const std::string& name) const;
+
+    // Binds the program unless it is already current. Every glUseProgram in
+    // the renderer goes through use()/unbind() so the tracking stays valid.
+    void use() const;
+    static void unbind();
+
+    // Setters expect this program to be current and skip the GL call when
+    // the uniform already holds the value.
+    void set(Uniform uniform, GLint value);
+    void set(Uniform uniform, GLfloat value);
+    void set(Uniform uniform, GLfloat x, GLfloat y);
+    void set(Uniform uniform, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+
     [[nodiscard]] GLuint id() const noexcept { return m_id; }
     operator GLuint() const noexcept { return m_id; }
 
 private:
+    using CachedValue = std::array<std::uint32_t, 4>;
+
+    bool changed(Uniform uniform, const CachedValue& value);
+
     GLuint m_id = 0;
+    std::unordered_map<std::string, GLint> m_locations;
+    std::vector<CachedValue> m_values;
+    std::vector<bool> m_valueKnown;
 };
@@ -0,0 +1,116 @@
+#include "StreamingBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+size_t alignUp(size_t value, size_t alignment) {
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    reset();
+}
+
+void StreamingBuffer::reset() noexcept {
+    for (auto& fence : m_fences) {
+        if (fence != nullptr) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (m_buffer != 0) {
+        if (m_mapped != nullptr) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        // Draws already issued keep the storage alive until they retire.
+        glDeleteBuffers(1, &m_buffer);
+    }
+    m_buffer = 0;
+    m_mapped = nullptr;
+    m_regionBytes = 0;
+    m_cursor = 0;
+    m_region = 0;
+}
+
+void StreamingBuffer::allocate(size_t regionBytes) {
+    reset();
+    m_regionBytes = regionBytes;
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const auto capacity = static_cast<GLsizeiptr>(regionBytes * FramesInFlight);
+        glBufferStorage(GL_ARRAY_BUFFER, capacity, nullptr, flags);
+        m_mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, capacity, flags));
+        if (m_mapped != nullptr) return;
+        // Immutable storage cannot be respecified, so start over unmapped.
+        glDeleteBuffers(1, &m_buffer);
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    }
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(regionBytes), nullptr, GL_STREAM_DRAW);
+}
+
+void StreamingBuffer::waitForRegion(int region) {
+    GLsync& fence = m_fences[region];
+    if (fence == nullptr) return;
+    for (;;) {
+        const GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        if (result != GL_TIMEOUT_EXPIRED) break;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamingBuffer::beginFrame() {
+    if (m_mapped == nullptr) return;
+    if (m_fences[m_region] != nullptr) glDeleteSync(m_fences[m_region]);
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % FramesInFlight;
+    waitForRegion(m_region);
+    m_cursor = 0;
+}
+
+GLint StreamingBuffer::upload(const void* data, size_t bytes, size_t stride) {
+    stride = std::max<size_t>(stride, 1);
+    if (m_buffer == 0) allocate(std::max(InitialRegionBytes, alignUp(bytes, stride) + stride));
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    if (m_mapped != nullptr) {
+        size_t base = m_regionBytes * m_region;
+        size_t offset = alignUp(base + m_cursor, stride);
+        if (offset + bytes > base + m_regionBytes) {
+            // This frame outgrew its region. Let the GPU drain, then restart
+            // with larger regions so later frames fit without stalling.
+            for (int region = 0; region < FramesInFlight; ++region) waitForRegion(region);
+            allocate(std::max(m_regionBytes * 2, alignUp(bytes, stride) + stride));
+            if (m_mapped == nullptr) return upload(data, bytes, stride);
+            base = 0;
+            offset = 0;
+        }
+        std::memcpy(m_mapped + offset, data, bytes);
+        m_cursor = offset + bytes - base;
+        return static_cast<GLint>(offset / stride);
+    }
+
+    size_t offset = alignUp(m_cursor, stride);
+    if (offset + bytes > m_regionBytes) {
+        // Orphan: the driver hands out fresh storage while queued draws keep
+        // reading the old block.
+        m_regionBytes = std::max(m_regionBytes, alignUp(bytes, stride) + stride);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_regionBytes), nullptr, GL_STREAM_DRAW);
+        offset = 0;
+    }
+    void* target = glMapBufferRange(
+        GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (target != nullptr) {
+        std::memcpy(target, data, bytes);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+    }
+    m_cursor = offset + bytes;
+    return static_cast<GLint>(offset / stride);
+}
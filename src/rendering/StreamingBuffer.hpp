@@ -0,0 +1,44 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+
+// Ring of vertex storage shared by all per-frame dynamic geometry. On GL 4.4
+// (or ARB_buffer_storage) the buffer is persistently mapped and split into
+// one region per frame in flight, each guarded by a fence. Older contexts
+// fall back to unsynchronized writes and orphan the buffer when it wraps.
+class StreamingBuffer {
+public:
+    static constexpr int FramesInFlight = 3;
+
+    StreamingBuffer() = default;
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    // Fences the region written this frame and waits until the next is free.
+    void beginFrame();
+    // Copies the vertices into the ring and leaves the buffer bound to
+    // GL_ARRAY_BUFFER. Attribute pointers must be (re)specified afterwards
+    // because growth replaces the buffer. Returns the first vertex index.
+    GLint upload(const void* data, size_t bytes, size_t stride);
+    void reset() noexcept;
+
+    [[nodiscard]] GLuint buffer() const noexcept { return m_buffer; }
+    [[nodiscard]] bool persistent() const noexcept { return m_mapped != nullptr; }
+
+private:
+    static constexpr size_t InitialRegionBytes = 2 * 1024 * 1024;
+
+    void allocate(size_t regionBytes);
+    void waitForRegion(int region);
+
+    GLuint m_buffer = 0;
+    unsigned char* m_mapped = nullptr;
+    size_t m_regionBytes = 0;
+    size_t m_cursor = 0;
+    int m_region = 0;
+    std::array<GLsync, FramesInFlight> m_fences{};
+};
@@ -59,7 +59,23 @@ Visualizer::Visualizer() {
         loadLyricsFont(defaultFont.string());
     }
     glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
+    glGenVertexArrays(1, &m_barVao);
+    glGenVertexArrays(1, &m_stripVao);
+    glGenVertexArrays(1, &m_gridVao);
+    glGenBuffers(1, &m_gridVbo);
+    glGenVertexArrays(1, &m_textVao);
+
+    // The GPU ribbon path pulls everything from the buffer texture, so its
+    // VAO carries no attributes.
+    glGenVertexArrays(1, &m_ribbonVao);
+    glGenBuffers(1, &m_ribbonBuffer);
+    glGenTextures(1, &m_ribbonTexture);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_ribbonBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, m_ribbonTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_ribbonBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &m_maxRibbonTexels);
 
     glEnable(GL_LINE_SMOOTH);
     glEnable(GL_POLYGON_SMOOTH);
@@ -70,9 +86,17 @@ Visualizer::Visualizer() {
 
 Visualizer::~Visualizer() {
     glDeleteVertexArrays(1, &m_vao);
-    glDeleteBuffers(1, &m_vbo);
+    glDeleteVertexArrays(1, &m_barVao);
+    glDeleteVertexArrays(1, &m_stripVao);
+    glDeleteVertexArrays(1, &m_gridVao);
+    glDeleteBuffers(1, &m_gridVbo);
+    glDeleteVertexArrays(1, &m_textVao);
     glDeleteVertexArrays(1, &m_quadVAO);
     glDeleteBuffers(1, &m_quadVBO);
+    glDeleteVertexArrays(1, &m_ribbonVao);
+    glDeleteBuffers(1, &m_ribbonBuffer);
+    glDeleteTextures(1, &m_ribbonTexture);
+    if (m_intensityTexture != 0) glDeleteTextures(1, &m_intensityTexture);
 }
 
 void Visualizer::initShaders() {
@@ -82,6 +106,59 @@ void Visualizer::initShaders() {
     m_quadShaderProgram.load(
         AssetPaths::shader("quad.vert"),
         AssetPaths::shader("quad.frag"));
+    m_ribbonShaderProgram.load(
+        AssetPaths::shader("xy_ribbon.vert"),
+        AssetPaths::shader("visualizer.frag"));
+    m_barShaderProgram.load(
+        AssetPaths::shader("bars.vert"),
+        AssetPaths::shader("visualizer.frag"));
+    m_stripShaderProgram.load(
+        AssetPaths::shader("spectrum_strip.vert"),
+        AssetPaths::shader("quad.frag"));
+    m_gridShaderProgram.load(
+        AssetPaths::shader("grid.vert"),
+        AssetPaths::shader("grid.frag"));
+    m_phosphorDecayProgram.load(
+        AssetPaths::shader("quad.vert"),
+        AssetPaths::shader("phosphor_decay.frag"));
+    m_phosphorComposeProgram.load(
+        AssetPaths::shader("quad.vert"),
+        AssetPaths::shader("phosphor_compose.frag"));
+
+    // Resolve every uniform once; draws only touch cached locations.
+    const auto& trace = m_shaderProgram;
+    m_shaderUniforms = {
+        trace.uniform("uColor"), trace.uniform("uCornerRadius"),
+        trace.uniform("uShape"), trace.uniform("uHalfWidth")};
+    const auto& quad = m_quadShaderProgram;
+    m_quadUniforms = {
+        quad.uniform("uUseTexture"), quad.uniform("uIsFont"), quad.uniform("uColor"),
+        quad.uniform("uSize"), quad.uniform("uOffset"), quad.uniform("uRotation"),
+        quad.uniform("uCornerRadius"), quad.uniform("uTexRect"), quad.uniform("uTexture"),
+        quad.uniform("uAspect")};
+    const auto& ribbon = m_ribbonShaderProgram;
+    m_ribbonUniforms = {
+        ribbon.uniform("uCenterline"), ribbon.uniform("uPointCount"), ribbon.uniform("uViewport"),
+        ribbon.uniform("uXScale"), ribbon.uniform("uShape"), ribbon.uniform("uColor"),
+        ribbon.uniform("uHalfWidth")};
+    const auto& bars = m_barShaderProgram;
+    m_barUniforms = {
+        bars.uniform("uShape"), bars.uniform("uAnchor"), bars.uniform("uMirrored"),
+        bars.uniform("uBarWidth"), bars.uniform("uHeightScale"), bars.uniform("uCornerRadius"),
+        bars.uniform("uColor")};
+    const auto& strip = m_stripShaderProgram;
+    m_stripUniforms = {
+        strip.uniform("uLeft"), strip.uniform("uCell"), strip.uniform("uHalfWidth"),
+        strip.uniform("uBaseline"), strip.uniform("uDirection"), strip.uniform("uUseTexture"),
+        strip.uniform("uIsFont"), strip.uniform("uCornerRadius"), strip.uniform("uColor")};
+    m_gridColorUniform = m_gridShaderProgram.uniform("uColor");
+    const auto& decay = m_phosphorDecayProgram;
+    m_phosphorDecayUniforms = {
+        decay.uniform("uFast"), decay.uniform("uSlow"), decay.uniform("uFastRetain"),
+        decay.uniform("uSlowRetain"), decay.uniform("uTransfer")};
+    const auto& compose = m_phosphorComposeProgram;
+    m_phosphorComposeUniforms = {
+        compose.uniform("uFast"), compose.uniform("uSlow"), compose.uniform("uSlowWeight")};
 }
 
 void Visualizer::setHeightScale(float scale) {
@@ -98,9 +175,8 @@ void Visualizer::setShape(VisualizerShape shape) {
 
 void Visualizer::setColor(float r, float g, float b, float a) {
     m_r = r; m_g = g; m_b = b; m_a = a; // Store for glow effect
-    glUseProgram(m_shaderProgram);
-    GLint colorLoc = glGetUniformLocation(m_shaderProgram, "uColor");
-    glUniform4f(colorLoc, r, g, b, a);
+    m_shaderProgram.use();
+    m_shaderProgram.set(m_shaderUniforms.color, r, g, b, a);
 }
 
 void Visualizer::setCornerRadius(float radius) {
@@ -127,46 +203,126 @@ void Visualizer::setBloomIntensity(float intensity) {
 
 void Visualizer::setupPersistence(int width, int height) {
     setViewportSize(width, height);
-    m_persistenceBuffer.resize(width, height);
+    for (auto& buffer : m_phosphorBuffers) {
+        buffer.resize(width, height, Framebuffer::Format::Rgba16F, 2);
+    }
+}
+
+void Visualizer::decayPersistence(float fastRetain, float slowRetain, float transfer) {
+    const Framebuffer& previous = m_phosphorBuffers[m_phosphorIndex];
+    m_phosphorIndex ^= 1;
+    const Framebuffer& current = m_phosphorBuffers[m_phosphorIndex];
+    if (!current.ready()) return;
+    current.bind();
+    glViewport(0, 0, current.width(), current.height());
+    if (fastRetain <= 0.0f && slowRetain <= 0.0f) {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        return;
+    }
+
+    glDisable(GL_BLEND);
+    m_phosphorDecayProgram.use();
+    m_phosphorDecayProgram.set(m_phosphorDecayUniforms.fast, 0);
+    m_phosphorDecayProgram.set(m_phosphorDecayUniforms.slow, 1);
+    m_phosphorDecayProgram.set(m_phosphorDecayUniforms.fastRetain, fastRetain);
+    m_phosphorDecayProgram.set(m_phosphorDecayUniforms.slowRetain, slowRetain);
+    m_phosphorDecayProgram.set(m_phosphorDecayUniforms.transfer, transfer);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, previous.texture(1));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, previous.texture(0));
+    glBindVertexArray(m_quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glEnable(GL_BLEND);
 }
 
 void Visualizer::beginPersistence() {
-    if (!m_persistenceBuffer.ready()) return;
-    m_persistenceBuffer.bind();
-    glViewport(0, 0, m_persistenceBuffer.width(), m_persistenceBuffer.height());
+    const Framebuffer& current = m_phosphorBuffers[m_phosphorIndex];
+    if (!current.ready()) return;
+    current.bindAttachment(0);
+    glViewport(0, 0, current.width(), current.height());
 }
 
 void Visualizer::endPersistence() {
     Framebuffer::unbind();
 }
 
-void Visualizer::drawPersistenceBuffer() {
-    if (!m_persistenceBuffer.ready()) return;
-    drawTexture(m_persistenceBuffer.texture());
+void Visualizer::drawPersistenceBuffer(float slowWeight) {
+    const Framebuffer& current = m_phosphorBuffers[m_phosphorIndex];
+    if (!current.ready()) return;
+    m_phosphorComposeProgram.use();
+    m_phosphorComposeProgram.set(m_phosphorComposeUniforms.fast, 0);
+    m_phosphorComposeProgram.set(m_phosphorComposeUniforms.slow, 1);
+    m_phosphorComposeProgram.set(m_phosphorComposeUniforms.slowWeight, slowWeight);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, current.texture(1));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, current.texture(0));
+    glBindVertexArray(m_quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
 void Visualizer::drawTexture(GLuint texture, float opacity) {
     if (texture == 0) return;
-    glUseProgram(m_quadShaderProgram);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 1);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uIsFont"), 0);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uColor"), 1.0f, 1.0f, 1.0f, opacity);
+    m_quadShaderProgram.use();
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 1);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 0);
+    m_quadShaderProgram.set(m_quadUniforms.color, 1.0f, 1.0f, 1.0f, opacity);
     
     // Ensure scale/offset are reset for persistence buffer
-    GLint sizeLoc = glGetUniformLocation(m_quadShaderProgram, "uSize");
-    GLint offsetLoc = glGetUniformLocation(m_quadShaderProgram, "uOffset");
-    if (sizeLoc != -1) glUniform2f(sizeLoc, 1.0f, 1.0f);
-    if (offsetLoc != -1) glUniform2f(offsetLoc, 0.0f, 0.0f);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), 0.0f);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uCornerRadius"), 0.0f);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uTexRect"), 0.0f, 0.0f, 1.0f, 1.0f);
+    m_quadShaderProgram.set(m_quadUniforms.size, 1.0f, 1.0f);
+    m_quadShaderProgram.set(m_quadUniforms.offset, 0.0f, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, 0.0f, 0.0f, 1.0f, 1.0f);
 
     glBindVertexArray(m_quadVAO);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uTexture"), 0);
+    m_quadShaderProgram.set(m_quadUniforms.texture, 0);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glUseProgram(0);
+}
+
+void Visualizer::drawIntensityMap(const std::vector<float>& intensity, int width, int height) {
+    if (width <= 0 || height <= 0 || intensity.size() < static_cast<size_t>(width) * height) return;
+    if (m_intensityTexture == 0) {
+        glGenTextures(1, &m_intensityTexture);
+        glBindTexture(GL_TEXTURE_2D, m_intensityTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // Single-channel energy reads as grey with full alpha in quad.frag.
+        const GLint swizzle[] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    glBindTexture(GL_TEXTURE_2D, m_intensityTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (width != m_intensityWidth || height != m_intensityHeight) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, intensity.data());
+        m_intensityWidth = width;
+        m_intensityHeight = height;
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_FLOAT, intensity.data());
+    }
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    m_quadShaderProgram.use();
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 1);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 0);
+    m_quadShaderProgram.set(m_quadUniforms.color, m_r, m_g, m_b, m_a);
+    m_quadShaderProgram.set(m_quadUniforms.size, 1.0f, 1.0f);
+    m_quadShaderProgram.set(m_quadUniforms.offset, 0.0f, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, 0.0f, 0.0f, 1.0f, 1.0f);
+    glBindVertexArray(m_quadVAO);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_intensityTexture);
+    m_quadShaderProgram.set(m_quadUniforms.texture, 0);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void Visualizer::drawTextureRegion(
@@ -182,24 +338,21 @@ void Visualizer::drawTextureRegion(
     float opacity
 ) {
     if (texture == 0) return;
-    glUseProgram(m_quadShaderProgram);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 1);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uIsFont"), 0);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uColor"), 1, 1, 1, opacity);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uSize"), halfWidth, halfHeight);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uOffset"), centerX, centerY);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), 0.0f);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uCornerRadius"), 0.0f);
-    glUniform4f(
-        glGetUniformLocation(m_quadShaderProgram, "uTexRect"),
-        textureX, textureY, textureWidth, textureHeight);
+    m_quadShaderProgram.use();
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 1);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 0);
+    m_quadShaderProgram.set(m_quadUniforms.color, 1, 1, 1, opacity);
+    m_quadShaderProgram.set(m_quadUniforms.size, halfWidth, halfHeight);
+    m_quadShaderProgram.set(m_quadUniforms.offset, centerX, centerY);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, textureX, textureY, textureWidth, textureHeight);
     glBindVertexArray(m_quadVAO);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uTexture"), 0);
+    m_quadShaderProgram.set(m_quadUniforms.texture, 0);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uTexRect"), 0, 0, 1, 1);
-    glUseProgram(0);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, 0, 0, 1, 1);
 }
 
 bool Visualizer::loadBackground(const std::string& path) {
@@ -213,54 +366,85 @@ void Visualizer::clearBackground() {
 void Visualizer::drawBackground(float scale, float shakeX, float shakeY, float rotation) {
     if (!m_backgroundTexture.loaded()) return;
 
-    glUseProgram(m_quadShaderProgram);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uSize"), scale, scale);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uOffset"), shakeX, shakeY);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), rotation);
+    m_quadShaderProgram.use();
+    m_quadShaderProgram.set(m_quadUniforms.size, scale, scale);
+    m_quadShaderProgram.set(m_quadUniforms.offset, shakeX, shakeY);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, rotation);
     
     glBindVertexArray(m_quadVAO);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, m_backgroundTexture.id());
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uTexture"), 0);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 1);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uColor"), 1, 1, 1, 1);
+    m_quadShaderProgram.set(m_quadUniforms.texture, 0);
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 1);
+    m_quadShaderProgram.set(m_quadUniforms.color, 1, 1, 1, 1);
 
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
     // Reset for subsequent passes
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uSize"), 1.0f, 1.0f);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uOffset"), 0.0f, 0.0f);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.size, 1.0f, 1.0f);
+    m_quadShaderProgram.set(m_quadUniforms.offset, 0.0f, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
 
-    glUseProgram(0);
 }
 
 void Visualizer::drawRoundedRect(float x, float y, float w, float h, float radius, const float color[4]) {
-    glUseProgram(m_quadShaderProgram);
+    m_quadShaderProgram.use();
     
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uSize"), w, h);
-    glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uOffset"), x, y);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.size, w, h);
+    m_quadShaderProgram.set(m_quadUniforms.offset, x, y);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
     
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uCornerRadius"), radius);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uAspect"), w / h);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 0);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uIsFont"), 0);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uColor"), color[0], color[1], color[2], color[3]);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uTexRect"), 0, 0, 1, 1);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, radius);
+    m_quadShaderProgram.set(m_quadUniforms.aspect, w / h);
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 0);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 0);
+    m_quadShaderProgram.set(m_quadUniforms.color, color[0], color[1], color[2], color[3]);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, 0, 0, 1, 1);
     
     glBindVertexArray(m_quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uCornerRadius"), 0.0f);
-    glUseProgram(0);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, 0.0f);
+}
+
+void Visualizer::drawBarStrip(
+    const std::vector<float>& heights,
+    float left,
+    float cell,
+    float halfWidth,
+    float baselineY,
+    float direction,
+    const float color[4]
+) {
+    if (heights.empty()) return;
+    glBindVertexArray(m_stripVao);
+    const GLint first = m_vertexStream.upload(heights.data(), heights.size() * sizeof(float), sizeof(float));
+    glVertexAttribPointer(
+        0, 1, GL_FLOAT, GL_FALSE, sizeof(float),
+        reinterpret_cast<void*>(static_cast<size_t>(first) * sizeof(float)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+
+    m_stripShaderProgram.use();
+    m_stripShaderProgram.set(m_stripUniforms.left, left);
+    m_stripShaderProgram.set(m_stripUniforms.cell, cell);
+    m_stripShaderProgram.set(m_stripUniforms.halfWidth, halfWidth);
+    m_stripShaderProgram.set(m_stripUniforms.baseline, baselineY);
+    m_stripShaderProgram.set(m_stripUniforms.direction, direction);
+    m_stripShaderProgram.set(m_stripUniforms.useTexture, 0);
+    m_stripShaderProgram.set(m_stripUniforms.isFont, 0);
+    m_stripShaderProgram.set(m_stripUniforms.cornerRadius, 0.0f);
+    m_stripShaderProgram.set(m_stripUniforms.color, color[0], color[1], color[2], color[3]);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(heights.size()));
 }
 
 bool Visualizer::loadFont(const std::string& path) {
+    m_textRuns.clear();
     return m_fontAtlas.load(Utf8Paths::fromUtf8(path), 48.0f);
 }
 
 bool Visualizer::loadLyricsFont(const std::string& path) {
+    m_textRuns.clear();
     return m_lyricsFontAtlas.load(Utf8Paths::fromUtf8(path), 48.0f);
 }
 
@@ -269,38 +453,48 @@ float Visualizer::measureTextWidth(
     float scale,
     VisualizerFont font
 ) {
-    FontAtlas& atlas = font == VisualizerFont::Lyrics ? m_lyricsFontAtlas : m_fontAtlas;
-    if (!atlas.loaded() || m_viewportWidth <= 0) return 0.0f;
-    float width = 0.0f;
-    for (const std::uint32_t codepoint : decodeUtf8(text)) {
-        if (const GlyphInfo* glyph = atlas.glyph(codepoint)) {
-            width += (2.0f * glyph->advanceX /
-                static_cast<float>(m_viewportWidth)) * scale;
-        }
-    }
-    return width;
+    const TextRun* run = shapedText(text, scale, font);
+    return run ? run->width : 0.0f;
 }
 
-void Visualizer::drawText(
+const Visualizer::TextRun* Visualizer::shapedText(
     const std::string& text,
-    float x,
-    float y,
     float scale,
-    const float color[4],
     VisualizerFont font
 ) {
     FontAtlas& atlas = font == VisualizerFont::Lyrics ? m_lyricsFontAtlas : m_fontAtlas;
-    if (!atlas.loaded()) return;
+    if (!atlas.loaded() || m_viewportWidth <= 0 || m_viewportHeight <= 0) return nullptr;
+    TextRunKey key{text, font, scale, m_viewportWidth, m_viewportHeight};
+    auto found = m_textRuns.find(key);
+    if (found == m_textRuns.end()) {
+        TextRun run;
+        run.width = appendTextQuads(run.vertices, atlas, text, 0.0f, 0.0f, scale);
+        found = m_textRuns.emplace(std::move(key), std::move(run)).first;
+    }
+    found->second.lastUsedFrame = m_frameIndex;
+    return &found->second;
+}
 
-    glUseProgram(m_quadShaderProgram);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, atlas.texture());
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uTexture"), 0);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 1);
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uColor"), color[0], color[1], color[2], color[3]);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uCornerRadius"), 0.0f);
-    glUniform1f(glGetUniformLocation(m_quadShaderProgram, "uRotation"), 0.0f);
+void Visualizer::beginFrame() {
+    m_vertexStream.beginFrame();
+    ++m_frameIndex;
+    // Timestamps and lyric lines come and go; drop runs idle for a few seconds.
+    constexpr std::uint64_t MaxIdleFrames = 300;
+    for (auto it = m_textRuns.begin(); it != m_textRuns.end();) {
+        if (m_frameIndex - it->second.lastUsedFrame > MaxIdleFrames) it = m_textRuns.erase(it);
+        else ++it;
+    }
+}
 
+float Visualizer::appendTextQuads(
+    std::vector<float>& vertices,
+    FontAtlas& atlas,
+    const std::string& text,
+    float x,
+    float y,
+    float scale
+) {
+    const float atlasSize = static_cast<float>(atlas.atlasSize());
     float curX = x;
     for (const std::uint32_t codepoint : decodeUtf8(text)) {
         if (codepoint < 32) continue;
@@ -308,36 +502,82 @@ void Visualizer::drawText(
         if (!glyph) continue;
         const GlyphInfo& ch = *glyph;
 
-        float w = (ch.width / (float)m_viewportWidth) * scale;
-        float h = (ch.height / (float)m_viewportHeight) * scale;
+        const float w = (ch.width / (float)m_viewportWidth) * scale;
+        const float h = (ch.height / (float)m_viewportHeight) * scale;
         const float leftOffset =
             (2.0f * ch.bearingLeft / static_cast<float>(m_viewportWidth)) * scale;
         const float topOffset =
             (-2.0f * ch.bearingTop / static_cast<float>(m_viewportHeight)) * scale;
-        
-        glUniform2f(glGetUniformLocation(m_quadShaderProgram, "uSize"), w, h);
-        glUniform2f(
-            glGetUniformLocation(m_quadShaderProgram, "uOffset"),
-            curX + leftOffset + w,
-            y + topOffset - h);
-        
-        const float atlasSize = static_cast<float>(atlas.atlasSize());
-        float tw = ch.width / atlasSize;
-        float th = ch.height / atlasSize;
-        glUniform4f(
-            glGetUniformLocation(m_quadShaderProgram, "uTexRect"),
-            ch.textureX, ch.textureY, tw, th);
-        glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uIsFont"), 1);
-
-        glBindVertexArray(m_quadVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        const float centerX = curX + leftOffset + w;
+        const float centerY = y + topOffset - h;
+        const float tw = ch.width / atlasSize;
+        const float th = ch.height / atlasSize;
+
+        // Same corner order and UV mapping as the unit quad in initQuad.
+        auto corner = [&](float px, float py, float u, float v) {
+            vertices.insert(vertices.end(), {
+                centerX + px * w, centerY + py * h, ch.textureX + u * tw, ch.textureY + v * th});
+        };
+        corner(-1.0f, 1.0f, 0.0f, 1.0f);
+        corner(-1.0f, -1.0f, 0.0f, 0.0f);
+        corner(1.0f, -1.0f, 1.0f, 0.0f);
+        corner(-1.0f, 1.0f, 0.0f, 1.0f);
+        corner(1.0f, -1.0f, 1.0f, 0.0f);
+        corner(1.0f, 1.0f, 1.0f, 1.0f);
 
         curX += (2.0f * ch.advanceX / static_cast<float>(m_viewportWidth)) * scale;
     }
+    return curX;
+}
+
+void Visualizer::drawText(
+    const std::string& text,
+    float x,
+    float y,
+    float scale,
+    const float color[4],
+    VisualizerFont font
+) {
+    const TextRun* run = shapedText(text, scale, font);
+    if (!run) return;
+    const FontAtlas& atlas = font == VisualizerFont::Lyrics ? m_lyricsFontAtlas : m_fontAtlas;
+    drawTextQuads(run->vertices, atlas.texture(), x, y, color);
+}
+
+void Visualizer::drawTextQuads(
+    const std::vector<float>& vertices,
+    GLuint texture,
+    float x,
+    float y,
+    const float color[4]
+) {
+    if (vertices.empty() || texture == 0) return;
+
+    // Runs are laid out at the origin; uOffset moves the whole run.
+    m_quadShaderProgram.use();
+    m_quadShaderProgram.set(m_quadUniforms.texture, 0);
+    m_quadShaderProgram.set(m_quadUniforms.useTexture, 1);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 1);
+    m_quadShaderProgram.set(m_quadUniforms.color, color[0], color[1], color[2], color[3]);
+    m_quadShaderProgram.set(m_quadUniforms.cornerRadius, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.rotation, 0.0f);
+    m_quadShaderProgram.set(m_quadUniforms.size, 1.0f, 1.0f);
+    m_quadShaderProgram.set(m_quadUniforms.offset, x, y);
+    m_quadShaderProgram.set(m_quadUniforms.texRect, 0.0f, 0.0f, 1.0f, 1.0f);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glBindVertexArray(m_textVao);
+    constexpr GLsizei stride = 4 * sizeof(float);
+    const GLint first = m_vertexStream.upload(vertices.data(), vertices.size() * sizeof(float), stride);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glDrawArrays(GL_TRIANGLES, first, static_cast<GLsizei>(vertices.size() / 4));
 
-    glUniform4f(glGetUniformLocation(m_quadShaderProgram, "uTexRect"), 0, 0, 1, 1);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uIsFont"), 0);
-    glUseProgram(0);
+    m_quadShaderProgram.set(m_quadUniforms.isFont, 0);
+    m_quadShaderProgram.set(m_quadUniforms.offset, 0.0f, 0.0f);
 }
 
 void Visualizer::initQuad() {
@@ -362,27 +602,6 @@ void Visualizer::initQuad() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 }
 
-void Visualizer::drawFullscreenDimmer(float decayRate) {
-    glUseProgram(m_quadShaderProgram);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    GLint colorLoc = glGetUniformLocation(m_quadShaderProgram, "uColor");
-    glUniform4f(colorLoc, 0.0f, 0.0f, 0.0f, decayRate);
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 0); // Tell shader not to use texture
-
-    GLint sizeLoc = glGetUniformLocation(m_quadShaderProgram, "uSize"); // FIXED: from uScale to uSize
-    GLint offsetLoc = glGetUniformLocation(m_quadShaderProgram, "uOffset");
-    if (sizeLoc != -1) glUniform2f(sizeLoc, 1.0f, 1.0f); // Make sure it covers the screen!
-    if (offsetLoc != -1) glUniform2f(offsetLoc, 0.0f, 0.0f);
-
-    glBindVertexArray(m_quadVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    
-    glUniform1i(glGetUniformLocation(m_quadShaderProgram, "uUseTexture"), 1); // Reset
-    glUseProgram(0);
-}
-
 void Visualizer::renderGrid() {
     if (!m_showGrid) return;
 
@@ -395,28 +614,36 @@ void Visualizer::renderGrid() {
         yScale = aspectRatio;
     }
 
-    glUseProgram(0);
-    glLineWidth(1.0f);
-    // Very subtle dark version of the color
-    glColor4f(m_r * 0.15f, m_g * 0.15f, m_b * 0.15f, m_a * 0.4f);
-    glBegin(GL_LINES);
-    const int columns = std::max(m_gridColumns, 1);
-    const int rows = std::max(m_gridRows, 1);
-    for (int i = 0; i <= columns; ++i) {
-        const float p = -1.0f + 2.0f * static_cast<float>(i) / columns;
-        glVertex2f(p * xScale, -1.0f * yScale);
-        glVertex2f(p * xScale, 1.0f * yScale);
+    const GridLayout layout{
+        std::max(m_gridColumns, 1), std::max(m_gridRows, 1), xScale, yScale, m_gridTicks, m_gridCrosshair};
+    if (!(layout == m_gridLayout) || m_gridVertexCount == 0) {
+        m_gridLayout = layout;
+        const auto grid = VisualizerGeometry::buildGraticule(
+            layout.columns, layout.rows, xScale, yScale, layout.ticks, layout.crosshair);
+        glBindVertexArray(m_gridVao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_gridVbo);
+        glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(float), grid.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        m_gridVertexCount = static_cast<GLsizei>(grid.size() / 3);
     }
-    for (int i = 0; i <= rows; ++i) {
-        const float p = -1.0f + 2.0f * static_cast<float>(i) / rows;
-        glVertex2f(-1.0f * xScale, p * yScale);
-        glVertex2f(1.0f * xScale, p * yScale);
-    }
-    glEnd();
+
+    m_gridShaderProgram.use();
+    // Very subtle dark version of the color
+    m_gridShaderProgram.set(m_gridColorUniform, m_r * 0.15f, m_g * 0.15f, m_b * 0.15f, m_a * 0.4f);
+    glLineWidth(1.0f);
+    glBindVertexArray(m_gridVao);
+    glDrawArrays(GL_LINES, 0, m_gridVertexCount);
 }
 
 void Visualizer::render(const std::vector<float>& magnitudes) {
     if (magnitudes.empty()) return;
+    if (m_shape == VisualizerShape::Bars || m_shape == VisualizerShape::Dots) {
+        renderInstancedBars(magnitudes);
+        return;
+    }
 
     std::vector<float> vertices;
     size_t numBars = magnitudes.size();
@@ -463,29 +690,7 @@ void Visualizer::render(const std::vector<float>& magnitudes) {
             }
         };
         
-        if (m_shape == VisualizerShape::Bars) {
-            // Define bar corners in local space
-            float x0 = x, y0 = -1.0f;
-            float x1 = x + width, y1 = -1.0f;
-            float x2 = x, y2 = -1.0f + h;
-            float x3 = x + width, y3 = -1.0f + h;
-            
-            // Transform to world space
-            float tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3;
-            transformCoord(x0, y0, tx0, ty0);
-            transformCoord(x1, y1, tx1, ty1);
-            transformCoord(x2, y2, tx2, ty2);
-            transformCoord(x3, y3, tx3, ty3);
-            
-            // First triangle
-            vertices.push_back(tx0); vertices.push_back(ty0); vertices.push_back(0.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tx1); vertices.push_back(ty1); vertices.push_back(1.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tx2); vertices.push_back(ty2); vertices.push_back(0.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-            // Second triangle
-            vertices.push_back(tx1); vertices.push_back(ty1); vertices.push_back(1.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tx3); vertices.push_back(ty3); vertices.push_back(1.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-            vertices.push_back(tx2); vertices.push_back(ty2); vertices.push_back(0.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-        } else if (m_shape == VisualizerShape::Lines) {
+        if (m_shape == VisualizerShape::Lines) {
             float lx0 = x + width/2, ly0 = -1.0f;
             float lx1 = x + width/2, ly1 = -1.0f + h;
             float tx0, ty0, tx1, ty1;
@@ -493,32 +698,6 @@ void Visualizer::render(const std::vector<float>& magnitudes) {
             transformCoord(lx1, ly1, tx1, ty1);
             vertices.push_back(tx0); vertices.push_back(ty0); vertices.push_back(0.5f); vertices.push_back(0.0f); vertices.push_back(1.0f);
             vertices.push_back(tx1); vertices.push_back(ty1); vertices.push_back(0.5f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-        } else if (m_shape == VisualizerShape::Dots) {
-            float dotSize = width * 0.8f;
-            float centerX = x + width/2;
-            float centerY = -1.0f + h;
-            
-            // Transform center
-            float tcx, tcy;
-            transformCoord(centerX, centerY, tcx, tcy);
-            
-            // For dots, we need to rotate the dot quad as well
-            // Simplification: use dotSize in both dimensions
-            float dx = dotSize/2;
-            float dy = dotSize/2;
-            
-            // Apply rotation for Left/Right anchors
-            if (m_barAnchor == BarAnchor::Left || m_barAnchor == BarAnchor::Right) {
-                std::swap(dx, dy);
-            }
-            
-            vertices.push_back(tcx - dx); vertices.push_back(tcy - dy); vertices.push_back(0.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tcx + dx); vertices.push_back(tcy - dy); vertices.push_back(1.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tcx - dx); vertices.push_back(tcy + dy); vertices.push_back(0.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-            
-            vertices.push_back(tcx + dx); vertices.push_back(tcy - dy); vertices.push_back(1.0f); vertices.push_back(0.0f); vertices.push_back(1.0f);
-            vertices.push_back(tcx + dx); vertices.push_back(tcy + dy); vertices.push_back(1.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
-            vertices.push_back(tcx - dx); vertices.push_back(tcy + dy); vertices.push_back(0.0f); vertices.push_back(1.0f); vertices.push_back(1.0f);
         }
     };
 
@@ -670,89 +849,53 @@ void Visualizer::render(const std::vector<float>& magnitudes) {
         }
     }
 
+    if (vertices.empty()) return;
     glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STREAM_DRAW);
-
-    // stride is now 5 floats
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(4 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    const GLint first = m_vertexStream.upload(vertices.data(), vertices.size() * sizeof(float), 5 * sizeof(float));
+    useDefaultVertexLayout();
 
-    glUseProgram(m_shaderProgram);
-    glUniform1f(glGetUniformLocation(m_shaderProgram, "uCornerRadius"), m_cornerRadius);
-    glUniform1i(glGetUniformLocation(m_shaderProgram, "uShape"), (int)m_shape);
+    m_shaderProgram.use();
+    m_shaderProgram.set(m_shaderUniforms.cornerRadius, m_cornerRadius);
+    m_shaderProgram.set(m_shaderUniforms.shape, (int)m_shape);
 
     if (m_shape == VisualizerShape::Lines) {
         glLineWidth(m_traceWidth);
-        glDrawArrays(GL_LINES, 0, (GLsizei)(vertices.size() / 5));
+        glDrawArrays(GL_LINES, first, (GLsizei)(vertices.size() / 5));
     } else if (m_shape == VisualizerShape::Waveform) {
         glLineWidth(m_traceWidth);
-        glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)(vertices.size() / 5));
+        glDrawArrays(GL_LINE_STRIP, first, (GLsizei)(vertices.size() / 5));
     } else if (m_shape == VisualizerShape::OscilloscopeXY || m_shape == VisualizerShape::OscilloscopeXY_Clean) {
         // Screen-space ribbons provide consistent widths on drivers that only support 1px lines.
         glBlendFunc(GL_SRC_ALPHA, GL_ONE);
         GLsizei vertexCount = (GLsizei)(vertices.size() / 5);
-        GLint colorLoc = glGetUniformLocation(m_shaderProgram, "uColor");
-
-        auto drawTracePass = [&](float width, float alphaMul, float whiteMix, float emission) {
-            std::vector<float> ribbon = VisualizerGeometry::buildTraceRibbon(
-                vertices, width, m_viewportWidth, m_viewportHeight);
-            if (ribbon.empty()) return;
-            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-            glBufferData(GL_ARRAY_BUFFER, ribbon.size() * sizeof(float), ribbon.data(), GL_STREAM_DRAW);
-            const float passR = m_r + (1.0f - m_r) * whiteMix;
-            const float passG = m_g + (1.0f - m_g) * whiteMix;
-            const float passB = m_b + (1.0f - m_b) * whiteMix;
-            glUniform4f(
-                colorLoc,
-                passR * emission,
-                passG * emission,
-                passB * emission,
-                m_a * alphaMul);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)(ribbon.size() / 5));
-        };
-
-        // Draw only the physical emissive beam here. The wide halo is now
-        // generated by BloomRenderer from values above the HDR threshold.
         const float bloom = std::clamp(m_bloomIntensity, 0.0f, 5.0f);
-        drawTracePass(
-            m_traceWidth + 1.5f, 0.35f, 0.0f,
-            0.55f + bloom * 0.2f);
-        drawTracePass(
-            m_traceWidth, 0.95f, 0.25f,
-            0.8f + bloom * 0.65f);
-
-        // Restore the centerline for the optional circular beam head.
+        drawTraceRibbon(vertices);
+
+        // Only the last centerline vertex is needed for the circular beam head.
         if (m_beamHeadSize > 0.01f && vertexCount > 0) {
-            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STREAM_DRAW);
-            glUniform1i(glGetUniformLocation(m_shaderProgram, "uShape"), 10); // Circular Point mode
+            const GLint head = m_vertexStream.upload(&vertices[vertices.size() - 5], 5 * sizeof(float), 5 * sizeof(float));
+            useDefaultVertexLayout();
+            m_shaderProgram.set(m_shaderUniforms.shape, 10); // Circular Point mode
             
             glPointSize(m_beamHeadSize);
             const float headEmission = 0.8f + bloom * 0.65f;
-            glUniform4f(
-                colorLoc,
+            m_shaderProgram.set(
+                m_shaderUniforms.color,
                 headEmission,
                 headEmission,
                 headEmission,
                 m_a);
-            glDrawArrays(GL_POINTS, vertexCount - 1, 1);
+            glDrawArrays(GL_POINTS, head, 1);
 
-            glUniform1i(glGetUniformLocation(m_shaderProgram, "uShape"), (int)m_shape); // Restore
+            m_shaderProgram.set(m_shaderUniforms.shape, (int)m_shape); // Restore
         }
 
         // Restore standard blending for other layers
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     } else if (m_shape == VisualizerShape::Curve) {
-        GLint colorLoc = glGetUniformLocation(m_shaderProgram, "uColor");
-        
         // Pass 1: Draw filled area with lower opacity
-        glUniform4f(colorLoc, m_r, m_g, m_b, m_a * m_fillOpacity);
-        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / 5));
+        m_shaderProgram.set(m_shaderUniforms.color, m_r, m_g, m_b, m_a * m_fillOpacity);
+        glDrawArrays(GL_TRIANGLES, first, (GLsizei)(vertices.size() / 5));
         
         // Pass 2: Draw the smooth line on top (full opacity)
         std::vector<float> lineVertices;
@@ -772,58 +915,175 @@ void Visualizer::render(const std::vector<float>& magnitudes) {
             lineVertices.push_back(1.0f);
         }
         
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(float), lineVertices.data(), GL_STREAM_DRAW);
+        if (lineVertices.empty()) return;
+        const GLint lineFirst = m_vertexStream.upload(
+            lineVertices.data(), lineVertices.size() * sizeof(float), 5 * sizeof(float));
+        useDefaultVertexLayout();
         
         glLineWidth(m_traceWidth);
-        glUniform4f(colorLoc, m_r, m_g, m_b, m_a);
-        glDrawArrays(GL_LINES, 0, (GLsizei)(lineVertices.size() / 5));
+        m_shaderProgram.set(m_shaderUniforms.color, m_r, m_g, m_b, m_a);
+        glDrawArrays(GL_LINES, lineFirst, (GLsizei)(lineVertices.size() / 5));
     } else {
-        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / 5));
+        glDrawArrays(GL_TRIANGLES, first, (GLsizei)(vertices.size() / 5));
     }
 }
 
-void Visualizer::renderXY(const XYTraceBatch& trace) {
-    if (trace.points.empty()) return;
+void Visualizer::renderInstancedBars(const std::vector<float>& magnitudes) {
+    const size_t numBars = magnitudes.size();
+    const float barWidth = m_mirrored ? (1.0f / numBars) : (2.0f / numBars);
+
+    glBindVertexArray(m_barVao);
+    const GLint first = m_vertexStream.upload(magnitudes.data(), numBars * sizeof(float), sizeof(float));
+    // Instanced attributes ignore the draw's first vertex, so offset the
+    // pointer instead. Mirrored layers reuse each magnitude for two bars.
+    glVertexAttribPointer(
+        0, 1, GL_FLOAT, GL_FALSE, sizeof(float),
+        reinterpret_cast<void*>(static_cast<size_t>(first) * sizeof(float)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, m_mirrored ? 2 : 1);
+
+    m_barShaderProgram.use();
+    m_barShaderProgram.set(m_barUniforms.shape, static_cast<int>(m_shape));
+    m_barShaderProgram.set(m_barUniforms.anchor, static_cast<int>(m_barAnchor));
+    m_barShaderProgram.set(m_barUniforms.mirrored, m_mirrored ? 1 : 0);
+    m_barShaderProgram.set(m_barUniforms.barWidth, barWidth);
+    m_barShaderProgram.set(m_barUniforms.heightScale, m_heightScale);
+    m_barShaderProgram.set(m_barUniforms.cornerRadius, m_cornerRadius);
+    m_barShaderProgram.set(m_barUniforms.color, m_r, m_g, m_b, m_a);
+    glDrawArraysInstanced(
+        GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_mirrored ? numBars * 2 : numBars));
 
     glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
+    m_shaderProgram.use();
+}
+
+void Visualizer::drawTraceRibbon(const std::vector<float>& centerline) {
+    if (m_gpuRibbonExpansion) {
+        std::vector<float> texels;
+        texels.reserve(centerline.size() / 5 * 4);
+        for (size_t i = 0; i + 5 <= centerline.size(); i += 5) {
+            texels.insert(texels.end(), {centerline[i], centerline[i + 1], centerline[i + 4], 0.0f});
+        }
+        if (drawGpuTraceRibbon(texels, 1.0f)) return;
+    }
+
+    // One upload serves both passes; the shader scales the unit offsets.
+    const auto ribbon = VisualizerGeometry::buildUnitTraceRibbon(
+        centerline, m_viewportWidth, m_viewportHeight);
+    if (ribbon.empty()) return;
+    constexpr GLsizei stride = 7 * sizeof(float);
+    const GLint first = m_vertexStream.upload(ribbon.data(), ribbon.size() * sizeof(float), stride);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(2 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(4 * sizeof(float)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
+
+    const float bloom = std::clamp(m_bloomIntensity, 0.0f, 5.0f);
+    const auto vertexCount = static_cast<GLsizei>(ribbon.size() / 7);
+    auto drawPass = [&](float width, float alpha, float whiteMix, float emission) {
+        m_shaderProgram.set(m_shaderUniforms.halfWidth, std::max(width, 1.0f) * 0.5f);
+        m_shaderProgram.set(
+            m_shaderUniforms.color,
+            (m_r + (1.0f - m_r) * whiteMix) * emission,
+            (m_g + (1.0f - m_g) * whiteMix) * emission,
+            (m_b + (1.0f - m_b) * whiteMix) * emission,
+            m_a * alpha);
+        glDrawArrays(GL_TRIANGLE_STRIP, first, vertexCount);
+    };
+    // Draw only the physical emissive beam here. The wide halo is
+    // generated by BloomRenderer from values above the HDR threshold.
+    drawPass(m_traceWidth + 1.5f, 0.35f, 0.0f, 0.55f + bloom * 0.2f);
+    drawPass(m_traceWidth, 0.95f, 0.25f, 0.8f + bloom * 0.65f);
+
+    // Back to the 5-float layout used by every other draw.
+    m_shaderProgram.set(m_shaderUniforms.halfWidth, 0.0f);
+    glDisableVertexAttribArray(3);
+    useDefaultVertexLayout();
+}
+
+void Visualizer::useDefaultVertexLayout() {
+    constexpr GLsizei stride = 5 * sizeof(float);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 5 * sizeof(float), reinterpret_cast<void*>(4 * sizeof(float)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(4 * sizeof(float)));
     glEnableVertexAttribArray(2);
-    glUseProgram(m_shaderProgram);
-    glUniform1i(glGetUniformLocation(m_shaderProgram, "uShape"), static_cast<int>(VisualizerShape::OscilloscopeXY));
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    const GLint colorLocation = glGetUniformLocation(m_shaderProgram, "uColor");
-    const float bloom = std::clamp(m_bloomIntensity, 0.0f, 5.0f);
+}
 
-    auto drawSegment = [&](const std::vector<float>& centerline) {
-        if (centerline.size() < 10) return;
-        auto drawPass = [&](float width, float alpha, float whiteMix, float emission) {
-            auto ribbon = VisualizerGeometry::buildTraceRibbon(
-                centerline, width, m_viewportWidth, m_viewportHeight);
-            if (ribbon.empty()) return;
-            glBufferData(GL_ARRAY_BUFFER, ribbon.size() * sizeof(float), ribbon.data(), GL_STREAM_DRAW);
-            glUniform4f(
-                colorLocation,
-                (m_r + (1.0f - m_r) * whiteMix) * emission,
-                (m_g + (1.0f - m_g) * whiteMix) * emission,
-                (m_b + (1.0f - m_b) * whiteMix) * emission,
-                m_a * alpha);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(ribbon.size() / 5));
-        };
-        drawPass(m_traceWidth + 1.5f, 0.35f, 0.0f, 0.55f + bloom * 0.2f);
-        drawPass(m_traceWidth, 0.95f, 0.25f, 0.8f + bloom * 0.65f);
+bool Visualizer::drawGpuTraceRibbon(const std::vector<float>& texels, float xScale) {
+    const size_t pointCount = texels.size() / 4;
+    if (pointCount < 2 || m_ribbonShaderProgram.id() == 0 ||
+        pointCount > static_cast<size_t>(std::max(m_maxRibbonTexels, 0))) {
+        return false;
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, m_ribbonBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, texels.size() * sizeof(float), texels.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, m_ribbonTexture);
+
+    m_ribbonShaderProgram.use();
+    m_ribbonShaderProgram.set(m_ribbonUniforms.centerline, 0);
+    m_ribbonShaderProgram.set(m_ribbonUniforms.pointCount, static_cast<GLint>(pointCount));
+    m_ribbonShaderProgram.set(m_ribbonUniforms.viewport, static_cast<float>(m_viewportWidth), static_cast<float>(m_viewportHeight));
+    m_ribbonShaderProgram.set(m_ribbonUniforms.xScale, xScale);
+    m_ribbonShaderProgram.set(m_ribbonUniforms.shape, static_cast<int>(VisualizerShape::OscilloscopeXY));
+    const float bloom = std::clamp(m_bloomIntensity, 0.0f, 5.0f);
+    const auto segmentCount = static_cast<GLsizei>(pointCount - 1);
+    glBindVertexArray(m_ribbonVao);
+    auto drawPass = [&](float width, float alpha, float whiteMix, float emission) {
+        m_ribbonShaderProgram.set(m_ribbonUniforms.halfWidth, std::max(width, 1.0f) * 0.5f);
+        m_ribbonShaderProgram.set(
+            m_ribbonUniforms.color,
+            (m_r + (1.0f - m_r) * whiteMix) * emission,
+            (m_g + (1.0f - m_g) * whiteMix) * emission,
+            (m_b + (1.0f - m_b) * whiteMix) * emission,
+            m_a * alpha);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, segmentCount);
     };
+    // Same two passes as the CPU ribbon in drawTraceRibbon.
+    drawPass(m_traceWidth + 1.5f, 0.35f, 0.0f, 0.55f + bloom * 0.2f);
+    drawPass(m_traceWidth, 0.95f, 0.25f, 0.8f + bloom * 0.65f);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindVertexArray(m_vao);
+    m_shaderProgram.use();
+    return true;
+}
+
+void Visualizer::renderXY(const XYTraceBatch& trace) {
+    if (trace.points.empty()) return;
 
     // XY coordinates are expressed in scope units, not stretched NDC units.
     // Compensate X for the framebuffer aspect so circles remain circles.
     const float xAspectCompensation = m_viewportWidth > 0
         ? static_cast<float>(m_viewportHeight) / static_cast<float>(m_viewportWidth)
         : 1.0f;
+    if (m_gpuRibbonExpansion) {
+        // The whole batch goes up in one draw; break flags blank the joins.
+        std::vector<float> texels;
+        texels.reserve(trace.points.size() * 4);
+        for (const auto& point : trace.points) {
+            texels.insert(texels.end(), {point.x, point.y, point.intensity, point.breakBefore ? 1.0f : 0.0f});
+        }
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        const bool drawn = drawGpuTraceRibbon(texels, xAspectCompensation);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        if (drawn) return;
+    }
+
+    glBindVertexArray(m_vao);
+    m_shaderProgram.use();
+    m_shaderProgram.set(m_shaderUniforms.shape, static_cast<int>(VisualizerShape::OscilloscopeXY));
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+    auto drawSegment = [&](const std::vector<float>& centerline) {
+        if (centerline.size() < 10) return;
+        drawTraceRibbon(centerline);
+    };
+
     std::vector<float> centerline;
     for (const auto& point : trace.points) {
         if (point.breakBefore) {
@@ -6,10 +6,15 @@
 #include "Framebuffer.hpp"
 #include "Texture2D.hpp"
 #include "FontAtlas.hpp"
+#include "StreamingBuffer.hpp"
 #include "XYOscilloscopeTypes.hpp"
 #include <GL/glew.h>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 enum class VisualizerFont {
     Primary,
@@ -23,8 +28,10 @@ public:
 
     void render(const std::vector<float>& magnitudes);
     void renderXY(const XYTraceBatch& trace);
+    // Uploads a bottom-up float intensity buffer and adds it tinted by the
+    // current color.
+    void drawIntensityMap(const std::vector<float>& intensity, int width, int height);
     void renderGrid();
-    void drawFullscreenDimmer(float decayRate);
     void setHeightScale(float scale);
     void setColor(float r, float g, float b, float a);
     void setMirrored(bool mirrored);
@@ -38,6 +45,10 @@ public:
     void setBloomIntensity(float intensity); // For XY oscilloscope bloom
     void setGridEnabled(bool enabled) { m_showGrid = enabled; }
     void setGridDivisions(int columns, int rows) { m_gridColumns = columns; m_gridRows = rows; }
+    void setGridDecorations(bool subdivisionTicks, bool crosshair) {
+        m_gridTicks = subdivisionTicks;
+        m_gridCrosshair = crosshair;
+    }
     void setTraceWidth(float width) { m_traceWidth = width; }
     void setFillOpacity(float opacity) { m_fillOpacity = opacity; }
     void setBeamHeadSize(float size) { m_beamHeadSize = size; }
@@ -47,26 +58,39 @@ public:
     void setOffset(float x, float y) { m_offsetX = x; m_offsetY = y; }
     void setScale(float x, float y) { m_scaleX = x; m_scaleY = y; }
     void setPersistenceEnabled(bool enabled) { m_persistenceEnabled = enabled; }
+    // Dynamic vertex storage; call beginFrame once per rendered frame.
+    void beginFrame();
+    [[nodiscard]] StreamingBuffer& vertexStream() noexcept { return m_vertexStream; }
+    // Expands XY ribbons in the vertex shader from a centerline texture buffer.
+    void setGpuRibbonExpansion(bool enabled) { m_gpuRibbonExpansion = enabled; }
 
-    // FBO Persistence
+    // FBO Persistence: fast phosphor in attachment 0, slow afterglow in
+    // attachment 1, ping-ponged so one MRT pass can decay both.
     void setupPersistence(int width, int height);
+    // Swaps buffers, then fast *= fastRetain and slow = slow * slowRetain +
+    // fast * transfer. Zero retention on both clears instead of drawing.
+    void decayPersistence(float fastRetain, float slowRetain, float transfer);
+    // Binds the fast layer only; traces drawn now feed the next decay.
     void beginPersistence();
     void endPersistence();
-    void drawPersistenceBuffer();
+    // Adds fast + slowWeight * slow to the bound target in one draw.
+    void drawPersistenceBuffer(float slowWeight = 0.0f);
     void drawTexture(GLuint texture, float opacity = 1.0f);
     void drawTextureRegion(
         GLuint texture, float centerX, float centerY, float halfWidth, float halfHeight,
         float textureX, float textureY, float textureWidth, float textureHeight,
         float opacity = 1.0f);
-    [[nodiscard]] GLuint persistenceTexture() const noexcept {
-        return m_persistenceBuffer.texture();
-    }
     
     // Background Image & Zen-Kun Effects
     bool loadBackground(const std::string& path);
     void drawBackground(float scale, float shakeX, float shakeY, float rotation);
     void clearBackground();
     void drawRoundedRect(float x, float y, float w, float h, float radius, const float color[4]);
+    // Square-cornered bars of equal width, one per height, from baselineY.
+    // Bar i is centred at left + (i + 0.5) * cell; zero heights draw nothing.
+    void drawBarStrip(
+        const std::vector<float>& heights, float left, float cell, float halfWidth,
+        float baselineY, float direction, const float color[4]);
     void drawText(
         const std::string& text, float x, float y, float scale,
         const float color[4], VisualizerFont font = VisualizerFont::Primary);
@@ -79,7 +103,91 @@ public:
 private:
     ShaderProgram m_shaderProgram;
     ShaderProgram m_quadShaderProgram;
-    GLuint m_vao = 0, m_vbo = 0;
+    ShaderProgram m_ribbonShaderProgram;
+    ShaderProgram m_barShaderProgram;
+    ShaderProgram m_stripShaderProgram;
+    ShaderProgram m_gridShaderProgram;
+    ShaderProgram::Uniform m_gridColorUniform;
+    ShaderProgram m_phosphorDecayProgram;
+    ShaderProgram m_phosphorComposeProgram;
+    struct PhosphorDecayUniforms {
+        ShaderProgram::Uniform fast, slow, fastRetain, slowRetain, transfer;
+    } m_phosphorDecayUniforms;
+    struct PhosphorComposeUniforms {
+        ShaderProgram::Uniform fast, slow, slowWeight;
+    } m_phosphorComposeUniforms;
+    struct TraceUniforms {
+        ShaderProgram::Uniform color, cornerRadius, shape, halfWidth;
+    } m_shaderUniforms;
+    struct QuadUniforms {
+        ShaderProgram::Uniform useTexture, isFont, color, size, offset, rotation;
+        ShaderProgram::Uniform cornerRadius, texRect, texture, aspect;
+    } m_quadUniforms;
+    struct RibbonUniforms {
+        ShaderProgram::Uniform centerline, pointCount, viewport, xScale, shape, color, halfWidth;
+    } m_ribbonUniforms;
+    struct BarUniforms {
+        ShaderProgram::Uniform shape, anchor, mirrored, barWidth, heightScale, cornerRadius, color;
+    } m_barUniforms;
+    struct StripUniforms {
+        ShaderProgram::Uniform left, cell, halfWidth, baseline, direction;
+        ShaderProgram::Uniform useTexture, isFont, cornerRadius, color;
+    } m_stripUniforms;
+    GLuint m_vao = 0;
+    GLuint m_barVao = 0;
+    GLuint m_stripVao = 0;
+
+    // Graticule geometry is rebuilt only when its layout changes.
+    struct GridLayout {
+        int columns = 0;
+        int rows = 0;
+        float xScale = 0.0f;
+        float yScale = 0.0f;
+        bool ticks = false;
+        bool crosshair = false;
+        bool operator==(const GridLayout& other) const noexcept {
+            return columns == other.columns && rows == other.rows && xScale == other.xScale &&
+                   yScale == other.yScale && ticks == other.ticks && crosshair == other.crosshair;
+        }
+    };
+    GridLayout m_gridLayout;
+    GLuint m_gridVao = 0, m_gridVbo = 0;
+    GLsizei m_gridVertexCount = 0;
+    GLuint m_textVao = 0;
+
+    // Laid-out text at the origin, reused until the string, font, scale or
+    // viewport changes. Font reloads clear the cache.
+    struct TextRun {
+        std::vector<float> vertices;
+        float width = 0.0f;
+        std::uint64_t lastUsedFrame = 0;
+    };
+    struct TextRunKey {
+        std::string text;
+        VisualizerFont font = VisualizerFont::Primary;
+        float scale = 1.0f;
+        int viewportWidth = 0;
+        int viewportHeight = 0;
+        bool operator==(const TextRunKey& other) const noexcept {
+            return text == other.text && font == other.font && scale == other.scale &&
+                   viewportWidth == other.viewportWidth && viewportHeight == other.viewportHeight;
+        }
+    };
+    struct TextRunKeyHash {
+        size_t operator()(const TextRunKey& key) const noexcept {
+            size_t hash = std::hash<std::string>{}(key.text);
+            hash ^= std::hash<float>{}(key.scale) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<size_t>(key.viewportWidth) * 73856093u ^
+                    static_cast<size_t>(key.viewportHeight) * 19349663u ^
+                    static_cast<size_t>(key.font);
+            return hash;
+        }
+    };
+    std::unordered_map<TextRunKey, TextRun, TextRunKeyHash> m_textRuns;
+    std::uint64_t m_frameIndex = 0;
+    StreamingBuffer m_vertexStream;
+    GLuint m_ribbonVao = 0, m_ribbonBuffer = 0, m_ribbonTexture = 0;
+    GLint m_maxRibbonTexels = 0;
     float m_heightScale = 0.2f;
     bool m_mirrored = false;
     VisualizerShape m_shape = VisualizerShape::Bars;
@@ -94,6 +202,8 @@ private:
     bool m_showGrid = true;
     int m_gridColumns = 10;
     int m_gridRows = 8;
+    bool m_gridTicks = false;
+    bool m_gridCrosshair = false;
     float m_traceWidth = 2.0f;
     float m_fillOpacity = 0.0f; // 0.0 = no fill, 1.0 = solid fill
     float m_beamHeadSize = 0.0f; // 0.0 = disabled
@@ -105,9 +215,14 @@ private:
     float m_scaleX = 1.0f;
     float m_scaleY = 1.0f;
     bool m_persistenceEnabled = true;
+    bool m_gpuRibbonExpansion = false;
 
-    Framebuffer m_persistenceBuffer;
+    std::array<Framebuffer, 2> m_phosphorBuffers;
+    int m_phosphorIndex = 0;
     GLuint m_quadVAO = 0, m_quadVBO = 0;
+    GLuint m_intensityTexture = 0;
+    int m_intensityWidth = 0;
+    int m_intensityHeight = 0;
 
     Texture2D m_backgroundTexture;
 
@@ -116,6 +231,21 @@ private:
 
     void initShaders();
     void initQuad();
+    void drawTraceRibbon(const std::vector<float>& centerline);
+    // Appends six x, y, u, v vertices per glyph and returns the pen position.
+    float appendTextQuads(
+        std::vector<float>& vertices, FontAtlas& atlas, const std::string& text,
+        float x, float y, float scale);
+    const TextRun* shapedText(const std::string& text, float scale, VisualizerFont font);
+    // One draw for a run of glyph quads sharing an atlas texture.
+    void drawTextQuads(
+        const std::vector<float>& vertices, GLuint texture, float x, float y, const float color[4]);
+    // Bars and dots: uploads one float per bar, geometry comes from bars.vert.
+    void renderInstancedBars(const std::vector<float>& magnitudes);
+    // Points attributes 0-2 at the 5-float layout in the bound buffer.
+    void useDefaultVertexLayout();
+    // Texels are x, y, intensity, break-before; X is multiplied by xScale.
+    bool drawGpuTraceRibbon(const std::vector<float>& texels, float xScale);
 };
 
 #endif // VISUALIZER_HPP
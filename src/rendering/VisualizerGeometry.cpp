@@ -12,18 +12,15 @@ float VisualizerGeometry::catmullRom(float p0, float p1, float p2, float p3, flo
     );
 }
 
-std::vector<float> VisualizerGeometry::buildTraceRibbon(
+std::vector<float> VisualizerGeometry::buildUnitTraceRibbon(
     const std::vector<float>& centerline,
-    float widthPixels,
     int viewportWidth,
     int viewportHeight
 ) {
     const size_t pointCount = centerline.size() / 5;
     std::vector<float> ribbon;
     if (pointCount < 2 || viewportWidth <= 0 || viewportHeight <= 0) return ribbon;
-    ribbon.reserve(pointCount * 10);
-
-    const float halfWidth = std::max(widthPixels, 1.0f) * 0.5f;
+    ribbon.reserve(pointCount * 14);
 
     auto direction = [&](size_t from, size_t to, float& x, float& y) {
         x = (centerline[to * 5] - centerline[from * 5]) * viewportWidth * 0.5f;
@@ -75,9 +72,7 @@ std::vector<float> VisualizerGeometry::buildTraceRibbon(
         const float outgoingNormalX = -outgoingY;
         const float outgoingNormalY = outgoingX;
         const float alignment = std::abs(normalX * outgoingNormalX + normalY * outgoingNormalY);
-        const float miterLength = std::min(
-            halfWidth / std::max(alignment, 0.25f),
-            halfWidth * 2.0f);
+        const float miterLength = std::min(1.0f / std::max(alignment, 0.25f), 2.0f);
 
         const float offsetX = normalX * miterLength * 2.0f / viewportWidth;
         const float offsetY = normalY * miterLength * 2.0f / viewportHeight;
@@ -85,8 +80,70 @@ std::vector<float> VisualizerGeometry::buildTraceRibbon(
         const float y = centerline[i * 5 + 1];
         const float intensity = centerline[i * 5 + 4];
 
-        ribbon.insert(ribbon.end(), {x + offsetX, y + offsetY, 0.0f, 0.0f, intensity});
-        ribbon.insert(ribbon.end(), {x - offsetX, y - offsetY, 0.0f, 1.0f, intensity});
+        ribbon.insert(ribbon.end(), {x, y, offsetX, offsetY, 0.0f, 0.0f, intensity});
+        ribbon.insert(ribbon.end(), {x, y, -offsetX, -offsetY, 0.0f, 1.0f, intensity});
     }
     return ribbon;
 }
+
+std::vector<float> VisualizerGeometry::buildTraceRibbon(
+    const std::vector<float>& centerline,
+    float widthPixels,
+    int viewportWidth,
+    int viewportHeight
+) {
+    const auto unit = buildUnitTraceRibbon(centerline, viewportWidth, viewportHeight);
+    const float halfWidth = std::max(widthPixels, 1.0f) * 0.5f;
+    std::vector<float> ribbon;
+    ribbon.reserve(unit.size() / 7 * 5);
+    for (size_t i = 0; i + 7 <= unit.size(); i += 7) {
+        ribbon.insert(ribbon.end(), {
+            unit[i] + unit[i + 2] * halfWidth, unit[i + 1] + unit[i + 3] * halfWidth,
+            unit[i + 4], unit[i + 5], unit[i + 6]});
+    }
+    return ribbon;
+}
+
+std::vector<float> VisualizerGeometry::buildGraticule(
+    int columns,
+    int rows,
+    float xScale,
+    float yScale,
+    bool subdivisionTicks,
+    bool crosshair
+) {
+    columns = std::max(columns, 1);
+    rows = std::max(rows, 1);
+    std::vector<float> lines;
+    auto line = [&](float x0, float y0, float x1, float y1, float weight) {
+        lines.insert(lines.end(), {x0 * xScale, y0 * yScale, weight, x1 * xScale, y1 * yScale, weight});
+    };
+
+    for (int i = 0; i <= columns; ++i) {
+        const float p = -1.0f + 2.0f * static_cast<float>(i) / columns;
+        line(p, -1.0f, p, 1.0f, 1.0f);
+    }
+    for (int i = 0; i <= rows; ++i) {
+        const float p = -1.0f + 2.0f * static_cast<float>(i) / rows;
+        line(-1.0f, p, 1.0f, p, 1.0f);
+    }
+    if (crosshair) {
+        line(0.0f, -1.0f, 0.0f, 1.0f, 1.6f);
+        line(-1.0f, 0.0f, 1.0f, 0.0f, 1.6f);
+    }
+    if (subdivisionTicks) {
+        constexpr int Subdivisions = 5;
+        constexpr float TickHalfLength = 0.015f;
+        for (int i = 1; i < columns * Subdivisions; ++i) {
+            if (i % Subdivisions == 0) continue;
+            const float p = -1.0f + 2.0f * static_cast<float>(i) / (columns * Subdivisions);
+            line(p, -TickHalfLength, p, TickHalfLength, 1.3f);
+        }
+        for (int i = 1; i < rows * Subdivisions; ++i) {
+            if (i % Subdivisions == 0) continue;
+            const float p = -1.0f + 2.0f * static_cast<float>(i) / (rows * Subdivisions);
+            line(-TickHalfLength, p, TickHalfLength, p, 1.3f);
+        }
+    }
+    return lines;
+}
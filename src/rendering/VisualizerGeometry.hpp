@@ -5,9 +5,29 @@
 namespace VisualizerGeometry {
 float catmullRom(float p0, float p1, float p2, float p3, float t);
 
+// Builds a triangle-strip ribbon for a width of one pixel per side. Each
+// vertex is x, y, offsetX, offsetY, localX, localY, intensity; the offset is
+// in NDC and is scaled by the half width at draw time, so several passes of
+// different widths can share one upload.
+std::vector<float> buildUnitTraceRibbon(
+    const std::vector<float>& centerline,
+    int viewportWidth,
+    int viewportHeight);
+
 std::vector<float> buildTraceRibbon(
     const std::vector<float>& centerline,
     float widthPixels,
     int viewportWidth,
     int viewportHeight);
+
+// Graticule line list scaled by the aspect factors. Each vertex is x, y,
+// weight: 1 for division lines, stronger for the centre crosshair and the
+// five-per-division ticks along the centre axes.
+std::vector<float> buildGraticule(
+    int columns,
+    int rows,
+    float xScale,
+    float yScale,
+    bool subdivisionTicks,
+    bool crosshair);
 }
@@ -1,7 +1,11 @@
 #include "XYOscilloscopeEngine.hpp"
 
+#include "CpuProfiler.hpp"
+#include "kiss_fft.h"
+
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 
 namespace {
@@ -39,45 +43,263 @@ float conditionAxis(
     return output;
 }
 
+// Streaming simplifier with a hard error bound: every sample it drops lies
+// within the tolerance of the emitted segment that replaces it. A merged
+// segment's intensity is rescaled so intensity x length matches the run of
+// samples it replaces, keeping dwell brightness unchanged.
+class TraceSimplifier {
+public:
+    TraceSimplifier(std::vector<XYTracePoint>& output, float tolerancePixels, float scaleX, float scaleY)
+        : m_output(output), m_tolerance(std::max(tolerancePixels, 0.01f)), m_scaleX(scaleX), m_scaleY(scaleY) {}
+
+    void push(const XYTracePoint& point) {
+        if (point.breakBefore || !m_hasAnchor) {
+            flush();
+            emit(point);
+            return;
+        }
+        const float length = distance(m_pending.empty() ? m_anchor : m_pending.back(), point);
+        if (!m_pending.empty() && (m_pending.size() >= MaxRun || !fits(point))) flush();
+        m_pending.push_back(point);
+        m_energy += length * point.intensity;
+        m_length += length;
+    }
+
+    void flush() {
+        if (m_pending.empty()) return;
+        XYTracePoint end = m_pending.back();
+        const float chord = distance(m_anchor, end);
+        // Runs that fold back on themselves cannot be matched by a shorter
+        // segment alone; the boost is capped so they stay plausible.
+        if (m_length > 0.0f) end.intensity = m_energy / std::max(chord, m_length * 0.5f);
+        emit(end);
+    }
+
+private:
+    static constexpr size_t MaxRun = 64;
+
+    float distance(const XYTracePoint& a, const XYTracePoint& b) const {
+        return std::hypot((b.x - a.x) * m_scaleX, (b.y - a.y) * m_scaleY);
+    }
+
+    bool fits(const XYTracePoint& end) const {
+        const float ax = m_anchor.x * m_scaleX, ay = m_anchor.y * m_scaleY;
+        const float dx = end.x * m_scaleX - ax, dy = end.y * m_scaleY - ay;
+        const float lengthSquared = dx * dx + dy * dy;
+        for (const auto& point : m_pending) {
+            const float px = point.x * m_scaleX - ax, py = point.y * m_scaleY - ay;
+            const float t = lengthSquared > 0.0f ? std::clamp((px * dx + py * dy) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+            if (std::hypot(px - t * dx, py - t * dy) > m_tolerance) return false;
+        }
+        return true;
+    }
+
+    void emit(const XYTracePoint& point) {
+        m_output.push_back(point);
+        m_anchor = point;
+        m_hasAnchor = true;
+        m_pending.clear();
+        m_energy = 0.0f;
+        m_length = 0.0f;
+    }
+
+    std::vector<XYTracePoint>& m_output;
+    float m_tolerance;
+    float m_scaleX, m_scaleY;
+    XYTracePoint m_anchor;
+    bool m_hasAnchor = false;
+    std::vector<XYTracePoint> m_pending;
+    float m_energy = 0.0f;
+    float m_length = 0.0f;
+};
+
+using PreparedSample = XYOscilloscopeEngine::PreparedSample;
+
+// Runs x, y and z through the band-limited upsampler. Outputs inherit the
+// invalid flag of the input samples they are interpolated between.
+std::vector<PreparedSample> upsampleSamples(
+    XYOscilloscopeEngine::UpsampleState& state, int factor,
+    const std::vector<PreparedSample>& input, bool block
+) {
+    factor = std::clamp(factor, 1, PolyphaseUpsampler::MaxFactor);
+    std::array<std::vector<float>, 3> channels;
+    for (auto& channel : channels) channel.reserve(input.size());
+    for (const auto& sample : input) {
+        channels[0].push_back(sample.x);
+        channels[1].push_back(sample.y);
+        channels[2].push_back(sample.z);
+    }
+    std::array<std::vector<float>, 3> upsampled;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        state.axes[axis].setFactor(factor);
+        if (block) state.axes[axis].processBlock(channels[axis].data(), input.size(), upsampled[axis]);
+        else state.axes[axis].process(channels[axis].data(), input.size(), upsampled[axis]);
+    }
+
+    std::vector<PreparedSample> output(upsampled[0].size());
+    const auto count = static_cast<size_t>(factor);
+    for (size_t n = 0; n < input.size(); ++n) {
+        bool before = false, after = false;
+        if (block) {
+            before = input[n].invalid;
+            after = n + 1 < input.size() && input[n + 1].invalid;
+        } else {
+            state.invalidHistory = (state.invalidHistory << 1) | (input[n].invalid ? 1u : 0u);
+            constexpr int delay = PolyphaseUpsampler::StreamDelay;
+            before = (state.invalidHistory >> delay) & 1u;
+            after = (state.invalidHistory >> (delay - 1)) & 1u;
+        }
+        for (size_t p = 0; p < count; ++p) {
+            const size_t index = n * count + p;
+            const bool onSample = block ? p == 0 : p + 1 == count;
+            output[index] = {upsampled[0][index], upsampled[1][index], upsampled[2][index],
+                             block ? before || (!onSample && after) : after || (!onSample && before)};
+        }
+    }
+    return output;
+}
+
+struct MeasurementInput {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::uint32_t sampleRate = 48000;
+    double sumX = 0.0, sumY = 0.0;
+    double squaresX = 0.0, squaresY = 0.0;
+    float peakX = 0.0f, peakY = 0.0f;
+    size_t count = 0;
+};
+
 float estimateFrequency(
     const std::vector<float>& values, std::uint32_t sampleRate, float& confidence
 ) {
-    std::vector<size_t> crossings;
+    // Running statistics over rising zero-crossing intervals. Crossings are
+    // interpolated between samples so short periods do not quantize.
+    double lastCrossing = -1.0;
+    size_t intervals = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
     for (size_t i = 1; i < values.size(); ++i) {
-        if (values[i - 1] <= 0.0f && values[i] > 0.0f) crossings.push_back(i);
-    }
-    if (crossings.size() < 3) { confidence = 0.0f; return 0.0f; }
-    float mean = 0.0f;
-    for (size_t i = 1; i < crossings.size(); ++i) mean += static_cast<float>(crossings[i] - crossings[i - 1]);
-    mean /= static_cast<float>(crossings.size() - 1);
-    float variance = 0.0f;
-    for (size_t i = 1; i < crossings.size(); ++i) {
-        const float difference = static_cast<float>(crossings[i] - crossings[i - 1]) - mean;
-        variance += difference * difference;
+        if (values[i - 1] > 0.0f || values[i] <= 0.0f) continue;
+        const double crossing = static_cast<double>(i - 1) +
+            values[i - 1] / static_cast<double>(values[i - 1] - values[i]);
+        if (lastCrossing >= 0.0) {
+            const double interval = crossing - lastCrossing;
+            ++intervals;
+            const double delta = interval - mean;
+            mean += delta / static_cast<double>(intervals);
+            m2 += delta * (interval - mean);
+        }
+        lastCrossing = crossing;
     }
-    variance /= static_cast<float>(crossings.size() - 1);
-    confidence = std::clamp(1.0f - std::sqrt(variance) / std::max(mean, 1.0f), 0.0f, 1.0f);
-    return static_cast<float>(sampleRate) / std::max(mean, 1.0f);
+    if (intervals < 2) { confidence = 0.0f; return 0.0f; }
+    const float period = std::max(static_cast<float>(mean), 1.0f);
+    const float deviation = std::sqrt(static_cast<float>(m2 / static_cast<double>(intervals)));
+    confidence = std::clamp(1.0f - deviation / period, 0.0f, 1.0f);
+    return static_cast<float>(sampleRate) / period;
 }
 
-XYMeasurements measure(const std::vector<float>& x, const std::vector<float>& y, std::uint32_t sampleRate) {
+// Finds the lag maximizing sum(x[i] * y[i + lag]) with one zero-padded FFT.
+// X and Y share the transform as real and imaginary parts.
+class PhaseCorrelator {
+public:
+    PhaseCorrelator() = default;
+    ~PhaseCorrelator() { release(); }
+
+    PhaseCorrelator(const PhaseCorrelator&) = delete;
+    PhaseCorrelator& operator=(const PhaseCorrelator&) = delete;
+
+    float bestLag(const std::vector<float>& x, const std::vector<float>& y, int maxLag) {
+        const size_t count = std::min(x.size(), y.size());
+        if (count < 4) return 0.0f;
+        size_t size = 1;
+        while (size < count * 2) size <<= 1;
+        prepare(size);
+
+        double meanX = 0.0, meanY = 0.0;
+        for (size_t i = 0; i < count; ++i) { meanX += x[i]; meanY += y[i]; }
+        meanX /= static_cast<double>(count);
+        meanY /= static_cast<double>(count);
+        for (size_t i = 0; i < size; ++i) {
+            m_time[i].r = i < count ? static_cast<float>(x[i] - meanX) : 0.0f;
+            m_time[i].i = i < count ? static_cast<float>(y[i] - meanY) : 0.0f;
+        }
+        kiss_fft(m_forward, m_time.data(), m_spectrum.data());
+
+        for (size_t k = 0; k < size; ++k) {
+            const kiss_fft_cpx z = m_spectrum[k];
+            const kiss_fft_cpx mirror = m_spectrum[(size - k) & (size - 1)];
+            const float xr = 0.5f * (z.r + mirror.r);
+            const float xi = 0.5f * (z.i - mirror.i);
+            const float yr = 0.5f * (z.i + mirror.i);
+            const float yi = -0.5f * (z.r - mirror.r);
+            m_product[k].r = xr * yr + xi * yi;
+            m_product[k].i = xr * yi - xi * yr;
+        }
+        kiss_fft(m_inverse, m_product.data(), m_time.data());
+
+        // Normalize by overlap so large lags are not penalized for having
+        // fewer contributing samples.
+        const int limit = std::clamp(maxLag, 1, static_cast<int>(count) - 2);
+        const auto value = [&](int lag) {
+            const size_t index = static_cast<size_t>((lag + static_cast<int>(size))) & (size - 1);
+            return m_time[index].r / static_cast<float>(count - static_cast<size_t>(std::abs(lag)));
+        };
+        int best = 0;
+        float bestValue = -std::numeric_limits<float>::infinity();
+        for (int lag = -limit; lag <= limit; ++lag) {
+            const float correlation = value(lag);
+            if (correlation > bestValue) { bestValue = correlation; best = lag; }
+        }
+        if (best <= -limit || best >= limit) return static_cast<float>(best);
+        const float before = value(best - 1);
+        const float after = value(best + 1);
+        const float curvature = before - 2.0f * bestValue + after;
+        if (curvature >= 0.0f) return static_cast<float>(best);
+        return static_cast<float>(best) +
+            std::clamp(0.5f * (before - after) / curvature, -0.5f, 0.5f);
+    }
+
+private:
+    void prepare(size_t size) {
+        if (size == m_size) return;
+        release();
+        m_forward = kiss_fft_alloc(static_cast<int>(size), 0, nullptr, nullptr);
+        m_inverse = kiss_fft_alloc(static_cast<int>(size), 1, nullptr, nullptr);
+        m_time.resize(size);
+        m_spectrum.resize(size);
+        m_product.resize(size);
+        m_size = size;
+    }
+
+    void release() noexcept {
+        kiss_fft_free(m_forward);
+        kiss_fft_free(m_inverse);
+        m_forward = nullptr;
+        m_inverse = nullptr;
+        m_size = 0;
+    }
+
+    size_t m_size = 0;
+    kiss_fft_cfg m_forward = nullptr;
+    kiss_fft_cfg m_inverse = nullptr;
+    std::vector<kiss_fft_cpx> m_time;
+    std::vector<kiss_fft_cpx> m_spectrum;
+    std::vector<kiss_fft_cpx> m_product;
+};
+
+XYMeasurements measure(const MeasurementInput& input) {
     XYMeasurements result;
-    if (x.empty() || x.size() != y.size()) return result;
-    double sumX = 0.0, sumY = 0.0, squaresX = 0.0, squaresY = 0.0;
-    for (size_t i = 0; i < x.size(); ++i) {
-        sumX += x[i]; sumY += y[i];
-        squaresX += static_cast<double>(x[i]) * x[i];
-        squaresY += static_cast<double>(y[i]) * y[i];
-        result.peakX = std::max(result.peakX, std::abs(x[i]));
-        result.peakY = std::max(result.peakY, std::abs(y[i]));
-    }
-    result.dcX = static_cast<float>(sumX / x.size());
-    result.dcY = static_cast<float>(sumY / y.size());
-    result.rmsX = std::sqrt(static_cast<float>(squaresX / x.size()));
-    result.rmsY = std::sqrt(static_cast<float>(squaresY / y.size()));
+    if (input.count == 0 || input.x.empty() || input.x.size() != input.y.size()) return result;
+    const double count = static_cast<double>(input.count);
+    result.peakX = input.peakX;
+    result.peakY = input.peakY;
+    result.dcX = static_cast<float>(input.sumX / count);
+    result.dcY = static_cast<float>(input.sumY / count);
+    result.rmsX = std::sqrt(static_cast<float>(input.squaresX / count));
+    result.rmsY = std::sqrt(static_cast<float>(input.squaresY / count));
     float confidenceX = 0.0f, confidenceY = 0.0f;
-    result.frequencyX = estimateFrequency(x, sampleRate, confidenceX);
-    result.frequencyY = estimateFrequency(y, sampleRate, confidenceY);
+    result.frequencyX = estimateFrequency(input.x, input.sampleRate, confidenceX);
+    result.frequencyY = estimateFrequency(input.y, input.sampleRate, confidenceY);
     result.confidence = std::min(confidenceX, confidenceY);
 
     if (result.frequencyX > 0.0f && result.frequencyY > 0.0f) {
@@ -96,95 +318,112 @@ XYMeasurements measure(const std::vector<float>& x, const std::vector<float>& y,
 
     if (result.confidence > 0.5f && result.frequencyX > 0.0f &&
         std::abs(result.frequencyX - result.frequencyY) / result.frequencyX < 0.03f) {
-        const int period = std::max(2, static_cast<int>(sampleRate / result.frequencyX));
-        int bestLag = 0;
-        double bestCorrelation = -std::numeric_limits<double>::infinity();
-        for (int lag = -period / 2; lag <= period / 2; ++lag) {
-            double correlation = 0.0;
-            for (size_t i = static_cast<size_t>(period); i + period < x.size(); ++i) {
-                const int shifted = static_cast<int>(i) + lag;
-                if (shifted >= 0 && shifted < static_cast<int>(y.size())) correlation += x[i] * y[shifted];
-            }
-            if (correlation > bestCorrelation) { bestCorrelation = correlation; bestLag = lag; }
-        }
-        result.phaseDegrees = 360.0f * bestLag / period;
+        thread_local PhaseCorrelator correlator;
+        const float period = static_cast<float>(input.sampleRate) / result.frequencyX;
+        const float lag = correlator.bestLag(
+            input.x, input.y, std::max(1, static_cast<int>(period * 0.5f)));
+        result.phaseDegrees = 360.0f * lag / period;
         result.phaseValid = true;
     }
     return result;
 }
+
+void recordMeasurementFrame(
+    XYOscilloscopeEngine::MeasurementState& state, std::uint64_t frame, float x, float y
+) {
+    constexpr size_t Window = XYOscilloscopeEngine::MeasurementWindow;
+    if (state.historyX.empty()) {
+        state.historyX.assign(Window, 0.0f);
+        state.historyY.assign(Window, 0.0f);
+    }
+    // Triggered acquisition hands over overlapping snapshots; only frames
+    // newer than the history are measured, and a gap restarts it.
+    if (state.historySize > 0 && frame < state.historyEnd) return;
+    if (state.historySize > 0 && frame > state.historyEnd) state.historySize = 0;
+
+    state.historyX[state.historyWrite] = x;
+    state.historyY[state.historyWrite] = y;
+    state.historyWrite = (state.historyWrite + 1) % Window;
+    state.historySize = std::min(state.historySize + 1, Window);
+    state.historyEnd = frame + 1;
+
+    state.sumX += x; state.sumY += y;
+    state.squaresX += static_cast<double>(x) * x;
+    state.squaresY += static_cast<double>(y) * y;
+    state.peakX = std::max(state.peakX, std::abs(x));
+    state.peakY = std::max(state.peakY, std::abs(y));
+    ++state.count;
+    ++state.framesSinceMeasurement;
 }
 
-XYTraceBatch XYOscilloscopeEngine::processContinuous(
-    LayerId id, const XYLayerSettings& settings, const XYInputChunk& input,
-    int width, int height
-) { return process(id, settings, input, true, width, height); }
+MeasurementInput takeMeasurementInput(
+    XYOscilloscopeEngine::MeasurementState& state, std::uint32_t sampleRate
+) {
+    constexpr size_t Window = XYOscilloscopeEngine::MeasurementWindow;
+    MeasurementInput input;
+    input.sampleRate = sampleRate;
+    input.x.resize(state.historySize);
+    input.y.resize(state.historySize);
+    const size_t first = (state.historyWrite + Window - state.historySize) % Window;
+    for (size_t i = 0; i < state.historySize; ++i) {
+        input.x[i] = state.historyX[(first + i) % Window];
+        input.y[i] = state.historyY[(first + i) % Window];
+    }
+    input.sumX = state.sumX; input.sumY = state.sumY;
+    input.squaresX = state.squaresX; input.squaresY = state.squaresY;
+    input.peakX = state.peakX; input.peakY = state.peakY;
+    input.count = state.count;
 
-XYTraceBatch XYOscilloscopeEngine::processTriggered(
-    LayerId id, const XYLayerSettings& settings, const XYInputChunk& input,
-    int width, int height
-) { return process(id, settings, input, false, width, height); }
+    state.sumX = state.sumY = 0.0;
+    state.squaresX = state.squaresY = 0.0;
+    state.peakX = state.peakY = 0.0f;
+    state.count = 0;
+    state.framesSinceMeasurement = 0;
+    state.measured = true;
+    return input;
+}
+}
 
-XYTraceBatch XYOscilloscopeEngine::process(
-    LayerId id, const XYLayerSettings& settings, const XYInputChunk& input,
-    bool continuous, int width, int height
+XYOscilloscopeEngine::XYOscilloscopeEngine(MeasurementScheduling scheduling)
+    : m_scheduling(scheduling) {}
+
+XYOscilloscopeEngine::Runtime& XYOscilloscopeEngine::runtimeFor(
+    LayerId id, const XYInputView& input
 ) {
-    Runtime& runtime = m_runtime[id];
+    auto [entry, inserted] = m_runtime.try_emplace(id);
+    Runtime& runtime = entry->second;
+    if (inserted) runtime.measurementEpoch = ++m_measurementEpoch;
     if (runtime.generation != input.discontinuityGeneration) {
         runtime = {};
         runtime.generation = input.discontinuityGeneration;
+        runtime.measurementEpoch = ++m_measurementEpoch;
     }
+    return runtime;
+}
 
-    size_t begin = 0;
-    if (!continuous && input.samples.size() > 1) {
-        const auto triggerValue = [&](size_t i) {
-            return settings.triggerSource == TriggerSource::X ? input.samples[i].x : input.samples[i].y;
-        };
-        const float low = settings.triggerLevel - settings.triggerHysteresis;
-        const float high = settings.triggerLevel + settings.triggerHysteresis;
-        bool armed = settings.triggerEdge == TriggerEdge::Rising ? triggerValue(0) < low : triggerValue(0) > high;
-        bool found = false;
-        for (size_t i = 1; i < input.samples.size(); ++i) {
-            const float value = triggerValue(i);
-            if (settings.triggerEdge == TriggerEdge::Rising) {
-                armed |= value < low;
-                if (armed && value >= high) { begin = i; found = true; break; }
-            } else {
-                armed |= value > high;
-                if (armed && value <= low) { begin = i; found = true; break; }
-            }
-        }
-        if (!found && settings.triggerMode == TriggerMode::Normal && !runtime.heldSweep.points.empty()) return runtime.heldSweep;
-    }
-
-    const size_t requestedFrames = std::max<size_t>(2, static_cast<size_t>(2048.0f * settings.windowScale));
-    const size_t end = continuous ? input.samples.size() : std::min(input.samples.size(), begin + requestedFrames);
-
-    XYTraceBatch batch;
-    batch.layerId = id;
-    batch.firstFrame = input.firstFrame + begin;
-    batch.sampleRate = input.sampleRate;
-    batch.continuous = continuous;
-    std::vector<float> conditionedX, conditionedY;
-    conditionedX.reserve(end - begin);
-    conditionedY.reserve(end - begin);
+XYOscilloscopeEngine::PreparedSample XYOscilloscopeEngine::prepareSample(
+    Runtime& runtime, const XYLayerSettings& settings,
+    const XYInputSample& sample, std::uint64_t frame, std::uint32_t sampleRate
+) {
+    const bool invalid = !std::isfinite(sample.x) || !std::isfinite(sample.y) || !std::isfinite(sample.z);
+    const float x = invalid ? 0.0f : conditionAxis(sample.x, settings.couplingX, settings.acCutoffHz, settings.bandwidthHz, sampleRate, runtime.xFilter);
+    const float y = invalid ? 0.0f : conditionAxis(sample.y, settings.couplingY, settings.acCutoffHz, settings.bandwidthHz, sampleRate, runtime.yFilter);
+    recordMeasurementFrame(runtime.measurement, frame, x, y);
+    return {x, y, sample.z, invalid};
+}
 
+void XYOscilloscopeEngine::buildTrace(
+    XYTraceBatch& batch, Runtime& runtime, const XYLayerSettings& settings,
+    const std::vector<PreparedSample>& prepared, bool hasZ, bool forceBreak,
+    int width, int height
+) {
+    // Upsampled points are closer together; dwell is judged per input frame.
+    const float samplesPerFrame = static_cast<float>(std::clamp(settings.upsampleFactor, 1, PolyphaseUpsampler::MaxFactor));
     float peak = 0.0f;
-    struct Prepared { float x, y, z; bool invalid; };
-    std::vector<Prepared> prepared;
-    prepared.reserve(end - begin);
-    for (size_t i = begin; i < end; ++i) {
-        const auto& sample = input.samples[i];
-        bool invalid = !std::isfinite(sample.x) || !std::isfinite(sample.y) || !std::isfinite(sample.z);
-        float x = invalid ? 0.0f : conditionAxis(sample.x, settings.couplingX, settings.acCutoffHz, settings.bandwidthHz, input.sampleRate, runtime.xFilter);
-        float y = invalid ? 0.0f : conditionAxis(sample.y, settings.couplingY, settings.acCutoffHz, settings.bandwidthHz, input.sampleRate, runtime.yFilter);
-        conditionedX.push_back(x); conditionedY.push_back(y);
-        peak = std::max({peak, std::abs(x), std::abs(y)});
-        prepared.push_back({x, y, sample.z, invalid});
-    }
-
+    for (const auto& sample : prepared) peak = std::max({peak, std::abs(sample.x), std::abs(sample.y)});
     if (settings.autoGain && peak > 1e-4f) {
         const float target = std::min(0.9f / peak, 16.0f);
-        const float seconds = static_cast<float>(prepared.size()) / std::max(input.sampleRate, 1u);
+        const float seconds = static_cast<float>(prepared.size()) / (static_cast<float>(std::max(batch.sampleRate, 1u)) * samplesPerFrame);
         const float rate = target < runtime.autoGain ? 12.0f : 2.5f;
         runtime.autoGain += (target - runtime.autoGain) * (1.0f - std::exp(-rate * seconds));
     } else if (!settings.autoGain) runtime.autoGain = 1.0f;
@@ -192,7 +431,9 @@ XYTraceBatch XYOscilloscopeEngine::process(
     const float angle = settings.rotationDegrees * Pi / 180.0f;
     const float cosine = std::cos(angle), sine = std::sin(angle);
     const float diagonal = std::sqrt(static_cast<float>(width * width + height * height));
-    bool forceBreak = input.dropped || !runtime.hasLast;
+    const size_t emittedBefore = batch.points.size();
+    if (!settings.simplifyTrace) batch.points.reserve(batch.points.size() + prepared.size());
+    TraceSimplifier simplifier(batch.points, settings.simplifyTolerancePx, width * 0.5f, height * 0.5f);
     for (size_t i = 0; i < prepared.size(); ++i) {
         float x = prepared[i].x * settings.gainX * runtime.autoGain;
         float y = prepared[i].y * settings.gainY * runtime.autoGain;
@@ -204,23 +445,238 @@ XYTraceBatch XYOscilloscopeEngine::process(
         const float dyPixels = (rotatedY - runtime.lastY) * height * 0.5f;
         const float distancePixels = std::hypot(dxPixels, dyPixels);
         const bool jump = runtime.hasLast && distancePixels > settings.jumpBlanking * diagonal;
-        const float dwell = 1.0f / (1.0f + distancePixels * 0.025f);
+        const float dwell = 1.0f / (1.0f + distancePixels * samplesPerFrame * 0.025f);
         float intensity = settings.beamIntensity * (1.0f + (dwell - 1.0f) * settings.dwellEffect);
         const float explicitZ = std::clamp(prepared[i].z * settings.zGain + settings.zOffset, 0.0f, 1.0f);
-        if (settings.zMode == ZIntensityMode::Explicit) intensity = input.hasZ ? explicitZ * settings.beamIntensity : 0.0f;
-        if (settings.zMode == ZIntensityMode::Multiply && input.hasZ) intensity *= explicitZ;
+        if (settings.zMode == ZIntensityMode::Explicit) intensity = hasZ ? explicitZ * settings.beamIntensity : 0.0f;
+        if (settings.zMode == ZIntensityMode::Multiply && hasZ) intensity *= explicitZ;
 
         const bool breakBefore = forceBreak || prepared[i].invalid || jump;
-        const bool closeToPrevious = runtime.hasLast && distancePixels < 0.35f && !breakBefore;
-        if (!closeToPrevious || i + 1 == prepared.size()) batch.points.push_back({rotatedX, rotatedY, intensity, breakBefore});
+        if (settings.simplifyTrace) {
+            simplifier.push({rotatedX, rotatedY, intensity, breakBefore});
+        } else {
+            const bool closeToPrevious = runtime.hasLast && distancePixels < 0.35f && !breakBefore;
+            if (!closeToPrevious || i + 1 == prepared.size()) batch.points.push_back({rotatedX, rotatedY, intensity, breakBefore});
+        }
         runtime.lastX = rotatedX; runtime.lastY = rotatedY;
         runtime.hasLast = !prepared[i].invalid;
         forceBreak = prepared[i].invalid;
     }
-    batch.measurements = measure(conditionedX, conditionedY, input.sampleRate);
-    if (!continuous && !batch.points.empty()) runtime.heldSweep = batch;
+    simplifier.flush();
+    batch.stats.sourcePoints += prepared.size();
+    batch.stats.emittedPoints += batch.points.size() - emittedBefore;
+}
+
+XYTraceBatch XYOscilloscopeEngine::processContinuous(
+    LayerId id, const XYLayerSettings& settings, const XYInputView& input,
+    int width, int height
+) {
+    return continuousTrace(id, runtimeFor(id, input), settings, input, width, height);
+}
+
+XYTraceBatch XYOscilloscopeEngine::processTriggered(
+    LayerId id, const XYLayerSettings& settings, const XYInputView& input,
+    int width, int height
+) {
+    return triggeredTrace(id, runtimeFor(id, input), settings, input, width, height);
+}
+
+void XYOscilloscopeEngine::processLayers(std::vector<LayerJob>& jobs, int width, int height) {
+    PLASMOID_PROFILE_FUNCTION();
+    // Runtimes are created up front so workers never touch the map itself.
+    std::vector<Runtime*> runtimes;
+    runtimes.reserve(jobs.size());
+    for (const auto& job : jobs) runtimes.push_back(&runtimeFor(job.layerId, job.input));
+
+    auto run = [&](size_t index) {
+        PLASMOID_PROFILE_ZONE("xy layer");
+        LayerJob& job = jobs[index];
+        job.trace = job.continuous
+            ? continuousTrace(job.layerId, *runtimes[index], job.settings, job.input, width, height)
+            : triggeredTrace(job.layerId, *runtimes[index], job.settings, job.input, width, height);
+    };
+    std::vector<Runtime*> sorted = runtimes;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        // Duplicate ids share a runtime and must not race.
+        for (size_t i = 0; i < jobs.size(); ++i) run(i);
+        return;
+    }
+    m_layerWorkers.parallelFor(jobs.size(), run);
+}
+
+XYTraceBatch XYOscilloscopeEngine::continuousTrace(
+    LayerId id, Runtime& runtime, const XYLayerSettings& settings,
+    const XYInputView& input, int width, int height
+) {
+    XYTraceBatch batch;
+    batch.layerId = id;
+    batch.firstFrame = input.firstFrame;
+    batch.sampleRate = input.sampleRate;
+    batch.continuous = true;
+
+    std::vector<PreparedSample> prepared;
+    prepared.reserve(input.count);
+    for (size_t i = 0; i < input.count; ++i) {
+        prepared.push_back(prepareSample(runtime, settings, input[i], input.firstFrame + i, input.sampleRate));
+    }
+    if (settings.upsampleFactor > 1) {
+        if (input.dropped) {
+            for (auto& axis : runtime.upsample.axes) axis.reset();
+        }
+        prepared = upsampleSamples(runtime.upsample, settings.upsampleFactor, prepared, false);
+    }
+    buildTrace(batch, runtime, settings, prepared, input.hasZ, input.dropped || !runtime.hasLast, width, height);
+    scheduleMeasurement(id, runtime, settings, input.sampleRate);
+    batch.measurements = runtime.measurement.latest;
     return batch;
 }
 
-void XYOscilloscopeEngine::reset(LayerId id) { m_runtime.erase(id); }
-void XYOscilloscopeEngine::resetAll() { m_runtime.clear(); }
+XYTraceBatch XYOscilloscopeEngine::triggeredTrace(
+    LayerId id, Runtime& runtime, const XYLayerSettings& settings,
+    const XYInputView& input, int width, int height
+) {
+    TriggerState& trigger = runtime.trigger;
+    const std::uint64_t inputEnd = input.firstFrame + input.count;
+    const std::uint32_t sampleRate = std::max(input.sampleRate, 1u);
+    const size_t sweepFrames = std::max<size_t>(2, static_cast<size_t>(2048.0f * settings.windowScale));
+    const auto holdoffFrames = static_cast<std::uint64_t>(
+        std::max(settings.triggerHoldoffMs, 0.0f) * 0.001f * static_cast<float>(sampleRate));
+    const std::uint64_t autoTimeout = std::max<std::uint64_t>(sweepFrames, sampleRate / 20);
+
+    // Frames already seen in an earlier, overlapping snapshot are skipped.
+    // Missing frames abort the sweep in progress and disarm the trigger.
+    if (!trigger.started || input.firstFrame > trigger.nextFrame || input.dropped) {
+        trigger = {};
+        trigger.started = true;
+        trigger.nextFrame = input.firstFrame;
+        trigger.idleSince = input.firstFrame;
+        trigger.holdoffUntil = input.firstFrame;
+    }
+
+    const float low = settings.triggerLevel - settings.triggerHysteresis;
+    const float high = settings.triggerLevel + settings.triggerHysteresis;
+    const bool rising = settings.triggerEdge == TriggerEdge::Rising;
+    bool completed = false;
+    for (std::uint64_t frame = std::max(trigger.nextFrame, input.firstFrame); frame < inputEnd; ++frame) {
+        const PreparedSample sample = prepareSample(
+            runtime, settings, input[static_cast<size_t>(frame - input.firstFrame)], frame, sampleRate);
+        const float value = settings.triggerSource == TriggerSource::X ? sample.x : sample.y;
+        const bool fired = !sample.invalid && trigger.armed && (rising ? value >= high : value <= low);
+        // An edge is consumed even when holdoff or a capture ignores it, so
+        // a sweep never starts partway up a slope.
+        if (fired) trigger.armed = false;
+        else if (!sample.invalid) trigger.armed |= rising ? value < low : value > high;
+
+        if (!trigger.capturing && frame >= trigger.holdoffUntil) {
+            const bool autoRun = settings.triggerMode == TriggerMode::Auto &&
+                                 frame - trigger.idleSince >= autoTimeout;
+            if (fired || autoRun) {
+                trigger.capturing = true;
+                trigger.sweepStart = frame;
+                trigger.capture.clear();
+                trigger.capture.reserve(sweepFrames);
+            }
+        }
+        if (!trigger.capturing) continue;
+
+        trigger.capture.push_back(sample);
+        if (trigger.capture.size() >= sweepFrames) {
+            trigger.capture.swap(trigger.ready);
+            trigger.readyStart = trigger.sweepStart;
+            trigger.capturing = false;
+            trigger.holdoffUntil = frame + 1 + holdoffFrames;
+            trigger.idleSince = trigger.holdoffUntil;
+            completed = true;
+        }
+    }
+    trigger.nextFrame = std::max(trigger.nextFrame, inputEnd);
+
+    scheduleMeasurement(id, runtime, settings, sampleRate);
+    if (!completed) {
+        XYTraceBatch held = runtime.heldSweep;
+        held.layerId = id;
+        held.measurements = runtime.measurement.latest;
+        return held;
+    }
+
+    // Each sweep starts with a blanked retrace from the previous one.
+    XYTraceBatch batch;
+    batch.layerId = id;
+    batch.firstFrame = trigger.readyStart;
+    batch.sampleRate = sampleRate;
+    batch.continuous = false;
+    if (settings.upsampleFactor > 1) {
+        const auto upsampled = upsampleSamples(runtime.upsample, settings.upsampleFactor, trigger.ready, true);
+        buildTrace(batch, runtime, settings, upsampled, input.hasZ, true, width, height);
+    } else {
+        buildTrace(batch, runtime, settings, trigger.ready, input.hasZ, true, width, height);
+    }
+    batch.measurements = runtime.measurement.latest;
+    if (!batch.points.empty()) runtime.heldSweep = batch;
+    return batch;
+}
+
+void XYOscilloscopeEngine::scheduleMeasurement(
+    LayerId id, Runtime& runtime, const XYLayerSettings& settings, std::uint32_t sampleRate
+) {
+    MeasurementState& state = runtime.measurement;
+    if (m_scheduling == MeasurementScheduling::Worker) {
+        std::lock_guard<std::mutex> lock(m_measurementMutex);
+        const auto published = m_published.find(id);
+        if (published != m_published.end() && published->second.epoch == runtime.measurementEpoch) {
+            if (published->second.ready) {
+                state.latest = published->second.measurements;
+                published->second.ready = false;
+            }
+            // One job per layer at a time; new frames keep accumulating.
+            if (published->second.pending) return;
+        }
+    }
+
+    if (settings.measurementRateHz <= 0.0f) {
+        state.latest = {};
+        return;
+    }
+    const auto interval = static_cast<size_t>(
+        std::max(static_cast<float>(sampleRate) / settings.measurementRateHz, 1.0f));
+    if (state.count == 0 || (state.measured && state.framesSinceMeasurement < interval)) return;
+
+    MeasurementInput input = takeMeasurementInput(state, sampleRate);
+    if (m_scheduling == MeasurementScheduling::Inline) {
+        state.latest = measure(input);
+        return;
+    }
+
+    const std::uint64_t epoch = runtime.measurementEpoch;
+    {
+        std::lock_guard<std::mutex> lock(m_measurementMutex);
+        PublishedMeasurement& slot = m_published[id];
+        slot.epoch = epoch;
+        slot.pending = true;
+        slot.ready = false;
+    }
+    m_measurementWorker.submit([this, id, epoch, input = std::move(input)] {
+        const XYMeasurements result = measure(input);
+        std::lock_guard<std::mutex> lock(m_measurementMutex);
+        const auto published = m_published.find(id);
+        if (published == m_published.end() || published->second.epoch != epoch) return;
+        published->second.measurements = result;
+        published->second.pending = false;
+        published->second.ready = true;
+    });
+}
+
+void XYOscilloscopeEngine::reset(LayerId id) {
+    m_runtime.erase(id);
+    std::lock_guard<std::mutex> lock(m_measurementMutex);
+    m_published.erase(id);
+}
+
+void XYOscilloscopeEngine::resetAll() {
+    m_runtime.clear();
+    std::lock_guard<std::mutex> lock(m_measurementMutex);
+    m_published.clear();
+}
+
+void XYOscilloscopeEngine::waitForMeasurements() { m_measurementWorker.waitIdle(); }
@@ -1,40 +1,139 @@
 #pragma once
 
 #include "XYOscilloscopeTypes.hpp"
+#include "WorkerPool.hpp"
+#include "PolyphaseUpsampler.hpp"
 
+#include <array>
+#include <mutex>
 #include <unordered_map>
 
 class XYOscilloscopeEngine {
 public:
+    // Worker publishes measurements asynchronously; Inline computes them in
+    // process() so tests and tools can read results from the same batch.
+    enum class MeasurementScheduling { Worker, Inline };
+
+    explicit XYOscilloscopeEngine(
+        MeasurementScheduling scheduling = MeasurementScheduling::Worker);
+
     XYTraceBatch processContinuous(
         LayerId layerId, const XYLayerSettings& settings,
-        const XYInputChunk& input, int viewportWidth, int viewportHeight);
+        const XYInputView& input, int viewportWidth, int viewportHeight);
     XYTraceBatch processTriggered(
         LayerId layerId, const XYLayerSettings& settings,
-        const XYInputChunk& input, int viewportWidth, int viewportHeight);
+        const XYInputView& input, int viewportWidth, int viewportHeight);
+
+    // One layer's input and settings for processLayers(). Layer ids must be
+    // unique within a call; each job's trace is written in place.
+    struct LayerJob {
+        LayerId layerId = 0;
+        XYLayerSettings settings;
+        XYInputView input;
+        bool continuous = true;
+        XYTraceBatch trace;
+    };
+    // Runs the CPU stage of every job across the layer worker pool.
+    void processLayers(std::vector<LayerJob>& jobs, int viewportWidth, int viewportHeight);
+
     void reset(LayerId layerId);
     void resetAll();
+    void waitForMeasurements();
+
+    // Number of conditioned frames kept per layer for frequency and phase.
+    static constexpr size_t MeasurementWindow = 16384;
 
     struct AxisFilter {
         float dcEstimate = 0.0f;
         float x1 = 0.0f, x2 = 0.0f;
         float y1 = 0.0f, y2 = 0.0f;
     };
+    struct MeasurementState {
+        std::vector<float> historyX;
+        std::vector<float> historyY;
+        size_t historyWrite = 0;
+        size_t historySize = 0;
+        std::uint64_t historyEnd = 0;
+        double sumX = 0.0, sumY = 0.0;
+        double squaresX = 0.0, squaresY = 0.0;
+        float peakX = 0.0f, peakY = 0.0f;
+        size_t count = 0;
+        size_t framesSinceMeasurement = 0;
+        bool measured = false;
+        XYMeasurements latest;
+    };
+    struct PreparedSample {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 1.0f;
+        bool invalid = false;
+    };
+    // Streaming trigger state. Frame positions are absolute input frames so
+    // edges and sweeps may span any number of chunks.
+    struct TriggerState {
+        bool started = false;
+        bool armed = false;
+        bool capturing = false;
+        std::uint64_t nextFrame = 0;
+        std::uint64_t holdoffUntil = 0;
+        std::uint64_t idleSince = 0;
+        std::uint64_t sweepStart = 0;
+        std::uint64_t readyStart = 0;
+        std::vector<PreparedSample> capture;
+        std::vector<PreparedSample> ready;
+    };
+    struct UpsampleState {
+        std::array<PolyphaseUpsampler, 3> axes;
+        // Bit k is set when the input k samples back was invalid.
+        std::uint32_t invalidHistory = 0;
+    };
     struct Runtime {
         AxisFilter xFilter;
         AxisFilter yFilter;
         std::uint64_t generation = 0;
+        std::uint64_t measurementEpoch = 0;
         float autoGain = 1.0f;
         float lastX = 0.0f;
         float lastY = 0.0f;
         bool hasLast = false;
+        MeasurementState measurement;
+        TriggerState trigger;
+        UpsampleState upsample;
         XYTraceBatch heldSweep;
     };
 
 private:
-    XYTraceBatch process(
-        LayerId layerId, const XYLayerSettings& settings,
-        const XYInputChunk& input, bool continuous,
+    struct PublishedMeasurement {
+        std::uint64_t epoch = 0;
+        bool pending = false;
+        bool ready = false;
+        XYMeasurements measurements;
+    };
+
+    Runtime& runtimeFor(LayerId layerId, const XYInputView& input);
+    XYTraceBatch continuousTrace(
+        LayerId layerId, Runtime& runtime, const XYLayerSettings& settings,
+        const XYInputView& input, int viewportWidth, int viewportHeight);
+    XYTraceBatch triggeredTrace(
+        LayerId layerId, Runtime& runtime, const XYLayerSettings& settings,
+        const XYInputView& input, int viewportWidth, int viewportHeight);
+    static PreparedSample prepareSample(
+        Runtime& runtime, const XYLayerSettings& settings,
+        const XYInputSample& sample, std::uint64_t frame, std::uint32_t sampleRate);
+    static void buildTrace(
+        XYTraceBatch& batch, Runtime& runtime, const XYLayerSettings& settings,
+        const std::vector<PreparedSample>& prepared, bool hasZ, bool forceBreak,
         int viewportWidth, int viewportHeight);
+    void scheduleMeasurement(
+        LayerId layerId, Runtime& runtime, const XYLayerSettings& settings,
+        std::uint32_t sampleRate);
+
+    MeasurementScheduling m_scheduling;
     std::unordered_map<LayerId, Runtime> m_runtime;
+    std::uint64_t m_measurementEpoch = 0;
+    std::mutex m_measurementMutex;
+    std::unordered_map<LayerId, PublishedMeasurement> m_published;
+    WorkerPool m_layerWorkers;
+    // Declared last so queued jobs finish before the state they publish to.
+    WorkerPool m_measurementWorker{1};
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -27,6 +29,31 @@ struct XYInputChunk {
     std::vector<XYInputSample> samples;
 };
 
+// Non-owning window into a chunk shared by several layers. The chunk must
+// outlive the view.
+struct XYInputView {
+    XYInputView() = default;
+    XYInputView(const XYInputChunk& chunk, size_t offset = 0)
+        : samples(chunk.samples.data() + std::min(offset, chunk.samples.size())),
+          count(chunk.samples.size() - std::min(offset, chunk.samples.size())),
+          firstFrame(chunk.firstFrame + std::min(offset, chunk.samples.size())),
+          sampleRate(chunk.sampleRate),
+          discontinuityGeneration(chunk.discontinuityGeneration),
+          hasZ(chunk.hasZ),
+          dropped(chunk.dropped && offset == 0) {}
+
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    const XYInputSample& operator[](size_t index) const noexcept { return samples[index]; }
+
+    const XYInputSample* samples = nullptr;
+    size_t count = 0;
+    std::uint64_t firstFrame = 0;
+    std::uint32_t sampleRate = 48000;
+    std::uint64_t discontinuityGeneration = 0;
+    bool hasZ = false;
+    bool dropped = false;
+};
+
 struct XYTracePoint {
     float x = 0.0f;
     float y = 0.0f;
@@ -50,6 +77,11 @@ struct XYMeasurements {
     bool phaseValid = false;
 };
 
+struct XYTraceStats {
+    size_t sourcePoints = 0;
+    size_t emittedPoints = 0;
+};
+
 struct XYTraceBatch {
     LayerId layerId = 0;
     std::uint64_t firstFrame = 0;
@@ -57,6 +89,7 @@ struct XYTraceBatch {
     bool continuous = false;
     std::vector<XYTracePoint> points;
     XYMeasurements measurements;
+    XYTraceStats stats;
 };
 
 struct XYLayerSettings {
@@ -68,6 +101,7 @@ struct XYLayerSettings {
     CouplingMode couplingY = CouplingMode::DC;
     float acCutoffHz = 5.0f;
     float bandwidthHz = 20000.0f;
+    int upsampleFactor = 1;
     float gainX = 1.0f;
     float gainY = 1.0f;
     float positionX = 0.0f;
@@ -84,6 +118,8 @@ struct XYLayerSettings {
     float triggerHysteresis = 0.02f;
     float triggerHoldoffMs = 0.0f;
     float jumpBlanking = 0.35f;
+    bool simplifyTrace = false;
+    float simplifyTolerancePx = 0.5f;
 
     float traceWidth = 2.0f;
     float bloom = 1.0f;
@@ -91,9 +127,12 @@ struct XYLayerSettings {
     float beamIntensity = 1.0f;
     float dwellEffect = 0.0f;
     float densityEffect = 0.0f;
+    bool cpuPhosphor = false;
     ZIntensityMode zMode = ZIntensityMode::Derived;
     float zGain = 1.0f;
     float zOffset = 0.0f;
+
+    float measurementRateHz = 10.0f;
 };
 
 struct OscilloscopeDisplaySettings {
@@ -102,6 +141,8 @@ struct OscilloscopeDisplaySettings {
     float graticuleOpacity = 0.18f;
     int graticuleColumns = 10;
     int graticuleRows = 8;
+    bool graticuleTicks = false;
+    bool graticuleCrosshair = false;
     float phosphorFastDecayMs = 65.0f;
     float phosphorSlowDecayMs = 500.0f;
     float phosphorSlowWeight = 0.25f;
@@ -109,4 +150,5 @@ struct OscilloscopeDisplaySettings {
     float decayColorShift = 0.08f;
     bool measurementOverlay = false;
     bool overlayInVideo = false;
+    bool gpuRibbonExpansion = false;
 };
@@ -20,6 +20,7 @@ void UIManager::renderUI(
     OscMusicEditor& oscMusicEditor,
     SystemStats& systemStats,
     VideoRenderManager& videoRenderManager,
+    GpuProfiler& gpuProfiler,
     GLFWwindow* window
 ) {
     renderMainMenu(state, audioEngine);
@@ -29,7 +30,7 @@ void UIManager::renderUI(
     renderLayerEditor(state);
     renderPlaylist(state, audioEngine);
     renderParticleSettings(state, particleSystem);
-    renderDebugInfo(state, systemStats, audioEngine, window);
+    renderDebugInfo(state, systemStats, audioEngine, gpuProfiler, window);
     renderGlobalSettings(state);
     renderLyricsEditor(state, audioEngine);
     renderStatusMessage(state);
@@ -9,6 +9,7 @@
 #include "imgui.h"
 
 class VideoRenderManager;
+class GpuProfiler;
 struct GLFWwindow;
 
 class UIManager {
@@ -20,6 +21,7 @@ public:
         OscMusicEditor& oscMusicEditor,
         SystemStats& systemStats,
         VideoRenderManager& videoRenderManager,
+        GpuProfiler& gpuProfiler,
         GLFWwindow* window
     );
 
@@ -31,12 +33,15 @@ private:
     void renderLayerEditor(AppState& state);
     void renderPlaylist(AppState& state, AudioEngine& audioEngine);
     void renderParticleSettings(AppState& state, ParticleSystem& particleSystem);
-    void renderDebugInfo(AppState& state, SystemStats& systemStats, AudioEngine& audioEngine, GLFWwindow* window);
+    void renderDebugInfo(AppState& state, SystemStats& systemStats, AudioEngine& audioEngine, GpuProfiler& gpuProfiler, GLFWwindow* window);
     void renderGlobalSettings(AppState& state);
     void renderLyricsEditor(AppState& state, AudioEngine& audioEngine);
     void renderStatusMessage(AppState& state);
 
     int m_selectedLyric = -1;
+    // Outcome of the last Debug Info export, shown beside its button.
+    std::string m_gpuExportResult;
+    std::string m_cpuTraceResult;
 };
 
 #endif // UI_MANAGER_HPP
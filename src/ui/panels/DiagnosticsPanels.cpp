@@ -6,14 +6,18 @@
 #include "imgui_impl_opengl3.h"
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cfloat>
 #include <cstring>
 #include <vector>
 #include <filesystem>
 #include "VideoRenderManager.hpp"
+#include "GpuProfiler.hpp"
+#include "CpuProfiler.hpp"
+#include "Utf8Paths.hpp"
 
 namespace fs = std::filesystem;
 
-void UIManager::renderDebugInfo(AppState& state, SystemStats& systemStats, AudioEngine& audioEngine, GLFWwindow* window) {
+void UIManager::renderDebugInfo(AppState& state, SystemStats& systemStats, AudioEngine& audioEngine, GpuProfiler& gpuProfiler, GLFWwindow* window) {
     if (state.showDebugInfo) {
         systemStats.update(ImGui::GetIO().DeltaTime);
         ImGui::Begin("Debug Info", &state.showDebugInfo);
@@ -36,7 +40,72 @@ void UIManager::renderDebugInfo(AppState& state, SystemStats& systemStats, Audio
         if (!state.enableVsync) {
             ImGui::Text("Target FPS: %d", state.targetFps);
         }
+
+        // === GPU PASSES ===
+        ImGui::Separator();
+        ImGui::Text("=== GPU Passes ===");
+        bool profileGpu = gpuProfiler.enabled();
+        if (ImGui::Checkbox("Time GPU passes", &profileGpu)) {
+            gpuProfiler.setEnabled(profileGpu);
+        }
+        if (gpuProfiler.enabled() && !gpuProfiler.passes().empty()) {
+            ImGui::Text("GPU Frame: %.2f ms", gpuProfiler.frameMs());
+            if (ImGui::BeginTable("GpuPasses", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+                ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                ImGui::TableSetupColumn("Avg", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                ImGui::TableHeadersRow();
+                for (const auto& pass : gpuProfiler.passes()) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%*s%s", pass.depth * 2, "", pass.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", pass.lastMs);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", pass.averageMs);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", pass.maxMs);
+                }
+                ImGui::EndTable();
+            }
+            const auto& frameHistory = gpuProfiler.passes().front().history;
+            ImGui::PlotLines("##GpuFrameHistory", frameHistory.data(),
+                static_cast<int>(frameHistory.size()), 0, "GPU frame (ms)",
+                0.0f, FLT_MAX, ImVec2(-1, 60));
+            if (ImGui::Button("Export CSV")) {
+                const fs::path path = fs::absolute("gpu_passes.csv");
+                m_gpuExportResult = gpuProfiler.exportCsv(path)
+                    ? "Written to " + Utf8Paths::toUtf8(path)
+                    : "Failed to write " + Utf8Paths::toUtf8(path);
+            }
+            if (!m_gpuExportResult.empty()) {
+                ImGui::SameLine();
+                ImGui::TextUnformatted(m_gpuExportResult.c_str());
+            }
+        }
         
+#ifdef PLASMOID_PROFILER
+        // === CPU TRACE ===
+        ImGui::Separator();
+        ImGui::Text("=== CPU Trace ===");
+        float frameBudget = CpuProfiler::frameBudgetMs();
+        if (ImGui::SliderFloat("Auto-capture budget (ms)", &frameBudget, 0.0f, 100.0f, "%.1f")) {
+            CpuProfiler::setFrameBudgetMs(frameBudget);
+        }
+        if (frameBudget <= 0.0f) ImGui::TextDisabled("A budget of 0 disables automatic capture.");
+        if (ImGui::Button("Write Trace")) {
+            const fs::path path = CpuProfiler::writeTrace();
+            m_cpuTraceResult = path.empty()
+                ? "Failed to write the trace."
+                : "Written to " + Utf8Paths::toUtf8(path);
+        }
+        if (!m_cpuTraceResult.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(m_cpuTraceResult.c_str());
+        }
+#endif
+
         // === AUDIO STATS ===
         ImGui::Separator();
         ImGui::Text("=== Audio ===");
@@ -85,7 +154,23 @@ void UIManager::renderDebugInfo(AppState& state, SystemStats& systemStats, Audio
         if (strlen(state.filePath) > 0) {
             ImGui::Text("File: %s", state.filePath);
         }
-        
+
+        // === XY TRACES ===
+        bool xyHeader = false;
+        for (const auto& layer : state.layers) {
+            if (layer.shape != VisualizerShape::OscilloscopeXY && layer.shape != VisualizerShape::OscilloscopeXY_Clean) continue;
+            if (!xyHeader) {
+                ImGui::Separator();
+                ImGui::Text("=== XY Traces ===");
+                xyHeader = true;
+            }
+            const auto& stats = layer.xyTraceStats;
+            const float ratio = stats.sourcePoints > 0
+                ? static_cast<float>(stats.emittedPoints) / static_cast<float>(stats.sourcePoints) : 1.0f;
+            ImGui::Text("%s: %zu -> %zu points (%.1f%%)", layer.name.c_str(),
+                stats.sourcePoints, stats.emittedPoints, ratio * 100.0f);
+        }
+
         ImGui::End();
     }
 }
@@ -103,12 +188,17 @@ void UIManager::renderGlobalSettings(AppState& state) {
             ImGui::SliderFloat("Graticule Opacity", &scope.graticuleOpacity, 0.0f, 1.0f);
             ImGui::SliderInt("Grid Columns", &scope.graticuleColumns, 1, 20);
             ImGui::SliderInt("Grid Rows", &scope.graticuleRows, 1, 20);
+            ImGui::Checkbox("Subdivision Ticks", &scope.graticuleTicks);
+            ImGui::SameLine();
+            ImGui::Checkbox("Center Crosshair", &scope.graticuleCrosshair);
             ImGui::SliderFloat("Fast Decay (ms)", &scope.phosphorFastDecayMs, 5.0f, 500.0f);
             ImGui::SliderFloat("Slow Decay (ms)", &scope.phosphorSlowDecayMs, 20.0f, 5000.0f);
             ImGui::SliderFloat("Slow Phosphor Weight", &scope.phosphorSlowWeight, 0.0f, 1.0f);
             ImGui::SliderFloat("Phosphor Saturation", &scope.phosphorSaturation, 0.0f, 3.0f);
             ImGui::Checkbox("Measurement Overlay", &scope.measurementOverlay);
             ImGui::Checkbox("Include Overlay in Video", &scope.overlayInVideo);
+            ImGui::Checkbox("GPU Ribbon Expansion", &scope.gpuRibbonExpansion);
+            ImGui::SameLine(); HelpMarker("Builds XY trace ribbons in the vertex shader from the uploaded centerline.");
         }
         
         ImGui::Text("Audio Input");
@@ -154,6 +154,8 @@ void UIManager::renderLayerEditor(AppState& state) {
                 if (ImGui::Combo("Y Coupling", &cy, coupling, 2)) xy.couplingY = static_cast<CouplingMode>(cy);
                 ImGui::SliderFloat("AC Cutoff (Hz)", &xy.acCutoffHz, 0.1f, 100.0f, "%.1f");
                 ImGui::SliderFloat("Bandwidth (Hz)", &xy.bandwidthHz, 100.0f, 24000.0f, "%.0f");
+                ImGui::SliderInt("Upsampling", &xy.upsampleFactor, 1, 8, "%dx");
+                ImGui::SameLine(); HelpMarker("Band-limited interpolation between samples. Rounds off polygon corners on fast figures.");
             }
             if (ImGui::CollapsingHeader("Beam / Z")) {
                 const char* zModes[] = {"Derived", "Explicit", "Derived x Explicit"}; int zMode = static_cast<int>(xy.zMode);
@@ -161,8 +163,14 @@ void UIManager::renderLayerEditor(AppState& state) {
                 ImGui::SliderFloat("Trace Thickness", &xy.traceWidth, 0.5f, 10.0f);
                 ImGui::SliderFloat("Bloom", &xy.bloom, 0.0f, 5.0f);
                 ImGui::SliderFloat("Dwell Effect", &xy.dwellEffect, 0.0f, 1.0f);
+                ImGui::Checkbox("CPU Phosphor", &xy.cpuPhosphor);
+                ImGui::SameLine(); HelpMarker("Accumulates the beam into a decaying hit map on the CPU instead of drawing GPU lines. Applies to persistent layers.");
+                if (xy.cpuPhosphor) ImGui::SliderFloat("Density Effect", &xy.densityEffect, 0.0f, 1.0f);
                 ImGui::SliderFloat("Max Connected Jump", &xy.jumpBlanking, 0.02f, 1.0f);
                 ImGui::SameLine(); HelpMarker("Lower values blank more long beam jumps. Start around 0.08 to remove retrace-like connectors.");
+                ImGui::Checkbox("Simplify Trace", &xy.simplifyTrace);
+                ImGui::SameLine(); HelpMarker("Merges nearly straight runs of samples. The drawn beam never strays further than the tolerance from the sampled path.");
+                if (xy.simplifyTrace) ImGui::SliderFloat("Tolerance (px)", &xy.simplifyTolerancePx, 0.1f, 4.0f, "%.2f");
                 if (ImGui::Combo("Z Mode", &zMode, zModes, 3)) xy.zMode = static_cast<ZIntensityMode>(zMode);
                 ImGui::SliderFloat("Z Gain", &xy.zGain, 0.0f, 2.0f);
                 layer.traceWidth = xy.traceWidth; layer.bloom = xy.bloom; layer.velocityModulation = xy.dwellEffect; layer.xyAutoGain = xy.autoGain;
@@ -177,6 +185,8 @@ void UIManager::renderLayerEditor(AppState& state) {
                 layer.rotation = xy.rotationDegrees; layer.xScale = xy.gainX; layer.yScale = xy.gainY; layer.xOffset = xy.positionX; layer.yOffset = xy.positionY; layer.flipX = xy.invertX; layer.flipY = xy.invertY;
             }
             if (ImGui::CollapsingHeader("Measurements")) {
+                ImGui::SliderFloat("Update Rate (Hz)", &xy.measurementRateHz, 0.0f, 30.0f, "%.1f");
+                ImGui::SameLine(); HelpMarker("Measurements run on a background worker at this rate. 0 disables them.");
                 const auto& m = layer.xyMeasurements;
                 ImGui::Text("X: %.2f Hz   Y: %.2f Hz   Ratio: %d:%d", m.frequencyX, m.frequencyY, m.ratioNumerator, m.ratioDenominator);
                 ImGui::Text("X peak/RMS/DC: %.3f / %.3f / %.3f", m.peakX, m.rmsX, m.dcX);
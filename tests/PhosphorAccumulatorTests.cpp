@@ -0,0 +1,69 @@
+#include "PhosphorAccumulator.hpp"
+#include "WorkerPool.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+namespace {
+XYTraceBatch line(float fromX, float toX, float intensity = 1.0f) {
+    XYTraceBatch batch;
+    batch.points = {{fromX, 0.0f, intensity, true}, {toX, 0.0f, intensity, false}};
+    return batch;
+}
+
+double total(const PhosphorAccumulator& accumulator) {
+    const auto& data = accumulator.data();
+    return std::accumulate(data.begin(), data.end(), 0.0);
+}
+
+bool near(double actual, double expected, double tolerance) {
+    return std::abs(actual - expected) <= tolerance;
+}
+}
+
+int main() {
+    PhosphorAccumulator serial;
+    serial.resize(200, 100);
+    serial.accumulate(line(-0.5f, 0.5f), {2.0f, 0.0f}, 1.0f);
+    const float peak = serial.data()[50 * 200 + 100];
+    if (!near(peak, 1.0, 0.15)) {
+        std::cerr << "Line centre should peak near its beam intensity\n";
+        return 1;
+    }
+    const double lineEnergy = 50.0 * std::sqrt(2.0 * 3.14159265) * 1.0;
+    if (!near(total(serial), lineEnergy, lineEnergy * 0.01)) {
+        std::cerr << "Splatted energy does not match the path length\n";
+        return 1;
+    }
+
+    WorkerPool pool(3);
+    PhosphorAccumulator banded;
+    banded.resize(200, 100);
+    banded.accumulate(line(-0.5f, 0.5f), {2.0f, 0.0f}, 1.0f, &pool);
+    for (size_t i = 0; i < serial.data().size(); ++i) {
+        if (!near(serial.data()[i], banded.data()[i], 1e-6)) {
+            std::cerr << "Banded accumulation differs from serial accumulation\n";
+            return 1;
+        }
+    }
+
+    serial.accumulate(XYTraceBatch{}, {2.0f, 0.0f}, 0.5f);
+    if (!near(serial.data()[50 * 200 + 100], peak * 0.5f, 1e-6)) {
+        std::cerr << "Decay was not applied to the accumulated energy\n";
+        return 1;
+    }
+
+    // With full density weighting each sample interval carries the same
+    // energy, so a slow short stroke is as bright in total as a long one.
+    PhosphorAccumulator shortStroke, longStroke;
+    shortStroke.resize(200, 100);
+    longStroke.resize(200, 100);
+    shortStroke.accumulate(line(-0.05f, 0.05f), {2.0f, 1.0f}, 1.0f);
+    longStroke.accumulate(line(-0.8f, 0.8f), {2.0f, 1.0f}, 1.0f);
+    if (!near(total(shortStroke), total(longStroke), total(longStroke) * 0.01)) {
+        std::cerr << "Density weighting did not give equal energy per interval\n";
+        return 1;
+    }
+    return 0;
+}
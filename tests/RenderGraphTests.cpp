@@ -0,0 +1,66 @@
+#include "RenderGraph.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    std::vector<std::string> order;
+    auto record = [&](const char* name) { return [&order, name] { order.push_back(name); }; };
+
+    // The slow phosphor history is only written when the scene samples it.
+    RenderGraph graph;
+    const auto target = graph.importResource("target");
+    const auto persistence = graph.importResource("persistence");
+    const auto slow = graph.importResource("slow");
+    const auto scene = graph.createTransient("scene", 1920, 1080);
+    graph.addPass("persistence", {}, {persistence}, record("persistence"));
+    graph.addPass("slow", {persistence, slow}, {slow}, record("slow"));
+    graph.addPass("scene", {persistence}, {scene}, record("scene"));
+    graph.addPass("compose", {scene}, {target}, record("compose"));
+    graph.addPass("overlay", {target}, {target}, record("overlay"));
+    graph.markOutput(target);
+    graph.compile();
+    graph.execute();
+    const std::vector<std::string> expected{"persistence", "scene", "compose", "overlay"};
+    if (order != expected || graph.passActive("slow") || graph.used(slow)) {
+        std::cerr << "Unused slow phosphor pass was not culled\n";
+        return 1;
+    }
+    if (graph.slot(scene) != 0 || graph.slot(target) != -1 || graph.slotCount() != 1) {
+        std::cerr << "Transient scene was not given a physical slot\n";
+        return 1;
+    }
+
+    // Transients with disjoint lifetimes share a slot; overlapping ones and
+    // ones of a different size or format do not.
+    graph.reset();
+    const auto output = graph.importResource("output");
+    const auto a = graph.createTransient("a", 640, 360);
+    const auto b = graph.createTransient("b", 640, 360);
+    const auto c = graph.createTransient("c", 640, 360);
+    const auto d = graph.createTransient("d", 320, 180);
+    const auto e = graph.createTransient("e", 640, 360, 1);
+    const auto unused = graph.createTransient("unused", 640, 360);
+    graph.addPass("write-a", {}, {a}, {});
+    graph.addPass("a-to-b", {a}, {b}, {});
+    graph.addPass("b-to-c", {b}, {c}, {});
+    graph.addPass("c-to-d", {c}, {d}, {});
+    graph.addPass("d-to-e", {d}, {e}, {});
+    graph.addPass("e-to-output", {e}, {output}, {});
+    graph.addPass("write-unused", {}, {unused}, {});
+    graph.markOutput(output);
+    graph.compile();
+    if (graph.slot(a) != graph.slot(c) || graph.slot(a) == graph.slot(b) ||
+        graph.slot(d) == graph.slot(a) || graph.slot(d) == graph.slot(b) ||
+        graph.slot(e) == graph.slot(a) || graph.slot(e) == graph.slot(b) ||
+        graph.slotFormat(graph.slot(e)) != 1) {
+        std::cerr << "Transient aliasing ignored lifetimes, sizes or formats\n";
+        return 1;
+    }
+    if (graph.slotCount() != 4 || graph.passActive("write-unused") || graph.slot(unused) != -1) {
+        std::cerr << "Pass writing an unread transient was not culled\n";
+        return 1;
+    }
+    return 0;
+}
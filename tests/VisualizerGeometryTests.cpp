@@ -32,6 +32,13 @@ int main() {
         return 1;
     }
 
+    const auto unitRibbon = VisualizerGeometry::buildUnitTraceRibbon(centerline, 100, 100);
+    if (unitRibbon.size() != 28 || !approximatelyEqual(unitRibbon[1] + unitRibbon[3] * 2.0f, ribbon[1]) ||
+        !approximatelyEqual(unitRibbon[8] + unitRibbon[10] * 2.0f, ribbon[6])) {
+        std::cerr << "Unit trace ribbon does not scale to the baked ribbon\n";
+        return 1;
+    }
+
     const std::vector<float> cornerWithDuplicate = {
         -0.5f, 0.0f, 0.0f, 0.0f, 1.0f,
          0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
@@ -51,5 +58,17 @@ int main() {
         }
     }
 
+    // 10x8 divisions: 11 + 9 lines, plus crosshair and 4 ticks per division.
+    const auto plain = VisualizerGeometry::buildGraticule(10, 8, 0.5f, 1.0f, false, false);
+    const auto decorated = VisualizerGeometry::buildGraticule(10, 8, 0.5f, 1.0f, true, true);
+    if (plain.size() != 20 * 6 || decorated.size() != (20 + 2 + 40 + 32) * 6) {
+        std::cerr << "Graticule has an unexpected line count\n";
+        return 1;
+    }
+    if (!approximatelyEqual(plain[0], -0.5f) || !approximatelyEqual(plain[1], -1.0f)) {
+        std::cerr << "Graticule ignores the aspect scale\n";
+        return 1;
+    }
+
     return 0;
 }
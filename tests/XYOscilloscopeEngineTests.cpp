@@ -1,10 +1,14 @@
 #include "XYOscilloscopeEngine.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace {
-XYInputChunk sineChunk(float frequencyX, float frequencyY, size_t count = 4800) {
+XYInputChunk sineChunk(
+    float frequencyX, float frequencyY, size_t count = 4800, float phaseY = 0.0f
+) {
     XYInputChunk chunk;
     chunk.sampleRate = 48000;
     chunk.discontinuityGeneration = 1;
@@ -12,7 +16,7 @@ XYInputChunk sineChunk(float frequencyX, float frequencyY, size_t count = 4800)
     constexpr float pi = 3.14159265358979323846f;
     for (size_t i = 0; i < count; ++i) {
         const float time = static_cast<float>(i) / chunk.sampleRate;
-        chunk.samples.push_back({std::sin(2.0f * pi * frequencyX * time), std::sin(2.0f * pi * frequencyY * time), 1.0f});
+        chunk.samples.push_back({std::sin(2.0f * pi * frequencyX * time), std::sin(2.0f * pi * frequencyY * time + phaseY), 1.0f});
     }
     return chunk;
 }
@@ -23,7 +27,7 @@ bool near(float actual, float expected, float tolerance) {
 }
 
 int main() {
-    XYOscilloscopeEngine engine;
+    XYOscilloscopeEngine engine(XYOscilloscopeEngine::MeasurementScheduling::Inline);
     XYLayerSettings settings;
     settings.bandwidthHz = 12000.0f;
 
@@ -53,19 +57,193 @@ int main() {
     XYLayerSettings triggered = settings;
     triggered.persistence = false;
     triggered.triggerMode = TriggerMode::Normal;
-    const auto sweep = engine.processTriggered(12, triggered, sineChunk(1000.0f, 1000.0f), 1280, 720);
+    const auto sweepChunk = sineChunk(1000.0f, 1000.0f);
+    const auto sweep = engine.processTriggered(12, triggered, sweepChunk, 1280, 720);
     if (sweep.points.empty()) {
         std::cerr << "Triggered acquisition did not produce a sweep\n";
         return 1;
     }
+    // Continues straight after the sweep chunk at the trigger level, inside
+    // the hysteresis band, so every sample is scanned and none can fire.
     XYInputChunk noTrigger;
+    noTrigger.firstFrame = sweepChunk.firstFrame + sweepChunk.samples.size();
     noTrigger.sampleRate = 48000;
     noTrigger.discontinuityGeneration = 1;
-    noTrigger.samples.assign(200, {0.8f, 0.0f, 1.0f});
+    noTrigger.samples.assign(200, {0.0f, 0.0f, 1.0f});
     const auto held = engine.processTriggered(12, triggered, noTrigger, 1280, 720);
     if (held.points.size() != sweep.points.size()) {
         std::cerr << "Normal trigger mode did not retain its last valid sweep\n";
         return 1;
     }
+
+    // Small chunks split edges and sweeps; triggers must still land one
+    // period apart and honour the holdoff after each completed sweep.
+    XYLayerSettings heldOff = triggered;
+    heldOff.triggerHoldoffMs = 20.0f;
+    const auto slow = sineChunk(100.0f, 100.0f, 48000);
+    std::vector<std::uint64_t> sweepStarts;
+    for (size_t offset = 0; offset < slow.samples.size(); offset += 100) {
+        XYInputChunk chunk = slow;
+        chunk.firstFrame = offset;
+        chunk.samples.assign(slow.samples.begin() + offset, slow.samples.begin() + offset + 100);
+        const auto batch = engine.processTriggered(14, heldOff, chunk, 1280, 720);
+        if (!batch.points.empty() && (sweepStarts.empty() || sweepStarts.back() != batch.firstFrame)) {
+            sweepStarts.push_back(batch.firstFrame);
+        }
+    }
+    if (sweepStarts.size() < 4) {
+        std::cerr << "Chunked trigger produced too few sweeps\n";
+        return 1;
+    }
+    for (size_t i = 2; i < sweepStarts.size(); ++i) {
+        const std::uint64_t spacing = sweepStarts[i] - sweepStarts[i - 1];
+        const std::uint64_t phase = spacing % 480;
+        if (spacing < 2048 + 960 || (phase > 2 && phase < 478)) {
+            std::cerr << "Chunked trigger lost edge alignment or holdoff\n";
+            return 1;
+        }
+    }
+
+    // A view into a shared slice must behave exactly like its own copy.
+    const auto shared = sineChunk(700.0f, 300.0f);
+    XYInputChunk tail = shared;
+    tail.firstFrame = 2400;
+    tail.samples.assign(shared.samples.begin() + 2400, shared.samples.end());
+    XYOscilloscopeEngine copyEngine(XYOscilloscopeEngine::MeasurementScheduling::Inline);
+    const auto fromCopy = copyEngine.processContinuous(17, settings, tail, 1280, 720);
+    const auto fromView = engine.processContinuous(17, settings, XYInputView(shared, 2400), 1280, 720);
+    if (fromView.firstFrame != 2400 || fromView.points.size() != fromCopy.points.size() ||
+        fromView.points.back().x != fromCopy.points.back().x) {
+        std::cerr << "Input view does not match a copied slice\n";
+        return 1;
+    }
+
+    const auto quadrature = engine.processContinuous(
+        13, settings, sineChunk(250.0f, 250.0f, 9600, 3.14159265f * 0.5f), 1280, 720);
+    if (!quadrature.measurements.phaseValid ||
+        !near(std::abs(quadrature.measurements.phaseDegrees), 90.0f, 2.0f)) {
+        std::cerr << "Phase measurement is inaccurate\n";
+        return 1;
+    }
+
+    // A slow 192 kHz circle must collapse to far fewer points while staying
+    // within tolerance of the sampled path and keeping intensity x length.
+    XYLayerSettings simplified = settings;
+    simplified.dwellEffect = 1.0f;
+    simplified.simplifyTrace = true;
+    simplified.simplifyTolerancePx = 0.5f;
+    XYInputChunk circle = sineChunk(50.0f, 50.0f, 19200, 3.14159265f * 0.5f);
+    circle.sampleRate = 192000;
+    XYOscilloscopeEngine referenceEngine(XYOscilloscopeEngine::MeasurementScheduling::Inline);
+    XYLayerSettings unsimplified = simplified;
+    unsimplified.simplifyTrace = false;
+    const auto reference = referenceEngine.processContinuous(15, unsimplified, circle, 1280, 720);
+    const auto reduced = engine.processContinuous(15, simplified, circle, 1280, 720);
+    if (reduced.stats.sourcePoints != circle.samples.size() ||
+        reduced.stats.emittedPoints != reduced.points.size() ||
+        reduced.points.size() * 4 > reference.points.size()) {
+        std::cerr << "Trace simplification did not reduce the point count\n";
+        return 1;
+    }
+    auto energy = [](const std::vector<XYTracePoint>& points) {
+        double total = 0.0;
+        for (size_t i = 1; i < points.size(); ++i) {
+            total += std::hypot((points[i].x - points[i - 1].x) * 640.0, (points[i].y - points[i - 1].y) * 360.0) * points[i].intensity;
+        }
+        return total;
+    };
+    if (!near(static_cast<float>(energy(reduced.points) / energy(reference.points)), 1.0f, 0.02f)) {
+        std::cerr << "Trace simplification changed the deposited beam energy\n";
+        return 1;
+    }
+    for (const auto& point : reference.points) {
+        float closest = 1e9f;
+        for (size_t i = 1; i < reduced.points.size(); ++i) {
+            const auto& a = reduced.points[i - 1];
+            const auto& b = reduced.points[i];
+            const float dx = (b.x - a.x) * 640.0f, dy = (b.y - a.y) * 360.0f;
+            const float px = (point.x - a.x) * 640.0f, py = (point.y - a.y) * 360.0f;
+            const float lengthSquared = dx * dx + dy * dy;
+            const float t = lengthSquared > 0.0f ? std::clamp((px * dx + py * dy) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+            closest = std::min(closest, std::hypot(px - t * dx, py - t * dy));
+        }
+        if (closest > 0.5f + 1e-3f) {
+            std::cerr << "Trace simplification exceeded its pixel tolerance\n";
+            return 1;
+        }
+    }
+
+    // Interpolated points must follow the band-limited signal between samples.
+    const auto tone = sineChunk(3000.0f, 3000.0f, 480);
+    std::vector<float> toneX;
+    for (const auto& sample : tone.samples) toneX.push_back(sample.x);
+    PolyphaseUpsampler upsampler(4);
+    std::vector<float> smooth;
+    upsampler.processBlock(toneX.data(), toneX.size(), smooth);
+    if (smooth.size() != toneX.size() * 4) {
+        std::cerr << "Upsampler produced the wrong number of points\n";
+        return 1;
+    }
+    for (size_t m = 64; m + 64 < smooth.size(); ++m) {
+        const float expected = std::sin(2.0f * 3.14159265f * 3000.0f * static_cast<float>(m) / (48000.0f * 4.0f));
+        if (!near(smooth[m], expected, 0.01f)) {
+            std::cerr << "Upsampler deviates from the band-limited signal\n";
+            return 1;
+        }
+    }
+    std::vector<float> streamed;
+    PolyphaseUpsampler streaming(4);
+    streaming.process(toneX.data(), 200, streamed);
+    streaming.process(toneX.data() + 200, toneX.size() - 200, streamed);
+    for (size_t m = 64; m < streamed.size(); ++m) {
+        const size_t aligned = m - (PolyphaseUpsampler::StreamDelay * 4 - 1);
+        if (!near(streamed[m], smooth[aligned], 1e-4f)) {
+            std::cerr << "Streaming upsampler is not continuous across chunks\n";
+            return 1;
+        }
+    }
+
+    XYLayerSettings upsampledSettings = settings;
+    upsampledSettings.upsampleFactor = 4;
+    const auto upsampledTrace = engine.processContinuous(16, upsampledSettings, tone, 1280, 720);
+    if (upsampledTrace.stats.sourcePoints != tone.samples.size() * 4) {
+        std::cerr << "Upsampling stage was not applied to the trace\n";
+        return 1;
+    }
+
+    XYOscilloscopeEngine serialEngine(XYOscilloscopeEngine::MeasurementScheduling::Inline);
+    XYOscilloscopeEngine parallelEngine(XYOscilloscopeEngine::MeasurementScheduling::Inline);
+    std::vector<XYInputChunk> chunks;
+    for (LayerId layer = 30; layer < 38; ++layer) chunks.push_back(sineChunk(1000.0f, 250.0f * (layer - 29)));
+    std::vector<XYOscilloscopeEngine::LayerJob> jobs;
+    for (LayerId layer = 30; layer < 38; ++layer) {
+        XYLayerSettings layerSettings = settings;
+        layerSettings.rotationDegrees = static_cast<float>(layer) * 10.0f;
+        const bool continuous = layer % 2 == 0;
+        jobs.push_back({layer, layerSettings, XYInputView(chunks[layer - 30]), continuous, {}});
+    }
+    parallelEngine.processLayers(jobs, 1280, 720);
+    for (const auto& job : jobs) {
+        const auto expected = job.continuous
+            ? serialEngine.processContinuous(job.layerId, job.settings, job.input, 1280, 720)
+            : serialEngine.processTriggered(job.layerId, job.settings, job.input, 1280, 720);
+        if (job.trace.layerId != job.layerId || job.trace.points.size() != expected.points.size() ||
+            job.trace.measurements.frequencyY != expected.measurements.frequencyY) {
+            std::cerr << "Parallel layer processing differs from serial processing\n";
+            return 1;
+        }
+    }
+
+    XYOscilloscopeEngine workerEngine;
+    XYInputChunk stream = sineChunk(1000.0f, 500.0f);
+    workerEngine.processContinuous(21, settings, stream, 1920, 1080);
+    workerEngine.waitForMeasurements();
+    stream.firstFrame = stream.samples.size();
+    const auto published = workerEngine.processContinuous(21, settings, stream, 1920, 1080);
+    if (!near(published.measurements.frequencyX, 1000.0f, 20.0f) ||
+        published.measurements.ratioNumerator != 2) {
+        std::cerr << "Worker measurements were not published to the next batch\n";
+        return 1;
+    }
     return 0;
 }